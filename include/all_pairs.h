@@ -0,0 +1,35 @@
+#ifndef ALL_PAIRS_H
+#define ALL_PAIRS_H
+
+#include "graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define ALL_PAIRS_BLOCK 32
+
+typedef enum AllPairsMethod {
+    ALL_PAIRS_AUTO,
+    ALL_PAIRS_FLOYD_WARSHALL,
+    ALL_PAIRS_DIJKSTRA
+} AllPairsMethod;
+
+typedef struct AllPairsTable {
+    int num_vertices;
+    int stride;
+    AllPairsMethod method;
+    int* distances;
+    int* predecessors;
+} AllPairsTable;
+
+AllPairsTable* build_all_pairs(Graph* graph, AllPairsMethod method,
+                               bool with_paths, int num_threads);
+void destroy_all_pairs(AllPairsTable* table);
+AllPairsMethod choose_all_pairs_method(Graph* graph);
+int all_pairs_distance(const AllPairsTable* table, int source, int target);
+int all_pairs_path(const AllPairsTable* table, int source, int target,
+                   int* path, int max_length);
+bool save_all_pairs(const AllPairsTable* table, const char* filename);
+AllPairsTable* load_all_pairs(const char* filename);
+
+#endif
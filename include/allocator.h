@@ -0,0 +1,40 @@
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include "graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define ALLOC_MAX_NUMA_NODES 64
+
+typedef enum PageMode {
+    PAGES_DEFAULT,
+    PAGES_TRANSPARENT_HUGE,
+    PAGES_EXPLICIT_HUGE
+} PageMode;
+
+typedef enum NumaPlacement {
+    NUMA_DEFAULT,
+    NUMA_LOCAL,
+    NUMA_INTERLEAVE,
+    NUMA_BIND
+} NumaPlacement;
+
+typedef struct AllocPolicy {
+    PageMode pages;
+    NumaPlacement placement;
+    int node;
+} AllocPolicy;
+
+void set_alloc_policy(AllocPolicy policy);
+AllocPolicy get_alloc_policy(void);
+void* policy_alloc(size_t size);
+void* policy_alloc_with(size_t size, AllocPolicy policy);
+void policy_free(void* ptr);
+int numa_node_count(void);
+bool pin_thread_to_node(int node);
+bool pin_worker_thread(int worker);
+Graph* replicate_graph(Graph* graph, int node);
+
+#endif
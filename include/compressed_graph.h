@@ -0,0 +1,26 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct CompressedGraph {
+    int num_vertices;
+    int num_edges;
+    int weight_bits;
+    uint32_t* edge_offsets;
+    uint32_t* byte_offsets;
+    uint8_t* adjacency;
+    uint8_t* weights;
+} CompressedGraph;
+
+CompressedGraph* compress_graph(Graph* graph);
+void destroy_compressed_graph(CompressedGraph* graph);
+size_t compressed_graph_memory_usage(const CompressedGraph* graph);
+DijkstraResult dijkstra_compressed(CompressedGraph* graph, int source);
+
+#endif
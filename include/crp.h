@@ -0,0 +1,60 @@
+#ifndef CRP_H
+#define CRP_H
+
+#include "graph.h"
+#include "priority_queue.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define CRP_MAX_LEVELS 8
+
+typedef struct CRPLevel {
+    int num_cells;
+    int* cell;
+    int* member_offsets;
+    int* members;
+    int* node_offsets;
+    int* nodes;
+    int* boundary_index;
+    int* boundary_offsets;
+    int* boundary_vertices;
+    int* clique_offsets;
+} CRPLevel;
+
+typedef struct CRPPartition {
+    int num_vertices;
+    int num_levels;
+    CRPLevel levels[CRP_MAX_LEVELS];
+} CRPPartition;
+
+typedef struct CRPQueryState {
+    int* distances;
+    int* touched;
+    int num_touched;
+    PriorityQueue* pq;
+    struct CRPQueryState* next;
+} CRPQueryState;
+
+typedef struct CRPOverlay {
+    CRPPartition* partition;
+    int* clique_weights[CRP_MAX_LEVELS];
+    bool customized;
+    Graph* customized_graph;
+    unsigned int customized_version;
+    pthread_key_t query_key;
+    pthread_mutex_t query_lock;
+    CRPQueryState* query_states;
+} CRPOverlay;
+
+CRPPartition* crp_create_partition(Graph* graph, int num_levels,
+                                   const int* cell_sizes);
+void crp_destroy_partition(CRPPartition* partition);
+CRPOverlay* crp_create_overlay(CRPPartition* partition);
+void crp_destroy_overlay(CRPOverlay* overlay);
+bool crp_customize(CRPOverlay* overlay, Graph* graph, int num_threads);
+bool crp_overlay_is_current(const CRPOverlay* overlay, const Graph* graph);
+int crp_query(CRPOverlay* overlay, Graph* graph, int source, int target);
+
+#endif
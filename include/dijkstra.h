@@ -13,11 +13,34 @@ typedef struct DijkstraResult {
     bool success;
 } DijkstraResult;
 
+typedef struct OneToManyResult {
+    int* distances;
+    int num_targets;
+    bool success;
+} OneToManyResult;
+
+typedef struct DijkstraStats {
+    long long vertices_settled;
+    long long edges_relaxed;
+    long long decrease_keys;
+} DijkstraStats;
+
+typedef struct DijkstraOptions {
+    bool record_parents;
+    int target;
+    DijkstraStats* stats;
+} DijkstraOptions;
+
 DijkstraResult dijkstra(Graph* graph, int source);
+DijkstraResult dijkstra_with_options(Graph* graph, int source,
+                                     const DijkstraOptions* options);
 DijkstraResult dijkstra_single_target(Graph* graph, int source, int target);
+OneToManyResult dijkstra_one_to_many(Graph* graph, int source,
+                                     const int* targets, int num_targets);
 void print_distances(DijkstraResult result, int num_vertices);
 void print_path(DijkstraResult result, int source, int destination);
 void free_dijkstra_result(DijkstraResult result);
+void free_one_to_many_result(OneToManyResult result);
 bool validate_dijkstra_input(Graph* graph, int source);
 
 #endif
\ No newline at end of file
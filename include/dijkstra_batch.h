@@ -0,0 +1,23 @@
+#ifndef DIJKSTRA_BATCH_H
+#define DIJKSTRA_BATCH_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define BATCH_LANES 8
+
+typedef struct BatchResult {
+    int* distances;
+    int num_sources;
+    int num_vertices;
+    bool success;
+} BatchResult;
+
+BatchResult dijkstra_batch(Graph* graph, const int* sources, int num_sources);
+int batch_distance(BatchResult result, int source_index, int vertex);
+void free_batch_result(BatchResult result);
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef DIJKSTRA_INTERLEAVED_H
+#define DIJKSTRA_INTERLEAVED_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include "priority_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define INTERLEAVE_WIDTH 4
+
+typedef enum QueryStage {
+    STAGE_START,
+    STAGE_EXTRACT,
+    STAGE_RELAX
+} QueryStage;
+
+typedef struct QuerySlot {
+    int query;
+    QueryStage stage;
+    int vertex;
+    Edge* edge;
+    PriorityQueue* pq;
+} QuerySlot;
+
+bool dijkstra_interleaved(Graph* graph, const int* sources, int num_sources,
+                          int width, DijkstraResult* results);
+
+#endif
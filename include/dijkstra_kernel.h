@@ -0,0 +1,105 @@
+#ifndef DIJKSTRA_KERNEL_H
+#define DIJKSTRA_KERNEL_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include "priority_queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+typedef struct DijkstraSearch {
+    PriorityQueue* pq;
+    int* distances;
+    int* parents;
+    int target;
+    const bool* is_target;
+    int remaining;
+    bool lazy;
+    DijkstraStats* stats;
+} DijkstraSearch;
+
+typedef enum DijkstraStop {
+    STOP_NONE,
+    STOP_TARGET,
+    STOP_TARGETS
+} DijkstraStop;
+
+/* Relaxes one edge. With LAZY, vertices enter the queue when first
+ * reached; otherwise every vertex was inserted up front and only queued
+ * vertices can improve. ON_DECREASE runs after a decrease-key. */
+#define DIJKSTRA_RELAX(pq, distances, parents, neighbor, new_distance,      \
+                       parent, PARENTS, LAZY, ON_DECREASE)                  \
+    do {                                                                    \
+        if ((new_distance) >= (distances)[neighbor]) {                      \
+            break;                                                          \
+        }                                                                   \
+        if ((LAZY) && (distances)[neighbor] == INF) {                       \
+            insert(pq, neighbor, new_distance);                             \
+        } else if (is_in_queue(pq, neighbor)) {                             \
+            decrease_key(pq, neighbor, new_distance);                       \
+            ON_DECREASE;                                                    \
+        } else {                                                            \
+            break;                                                          \
+        }                                                                   \
+        (distances)[neighbor] = (new_distance);                             \
+        if (PARENTS) (parents)[neighbor] = (parent);                        \
+    } while (0)
+
+/* FOR_EACH_EDGE(graph, u, neighbor, weight, parent) opens a loop over the
+ * out-edges of u, so the same search runs over any adjacency layout. */
+#define FOR_EACH_LIST_EDGE(graph, u, neighbor, weight, parent)              \
+    for (Edge* edge_ = (graph)->adjacency_list[u];                          \
+         edge_ && ((neighbor) = edge_->destination,                         \
+                   (weight) = edge_->weight, (parent) = (u), 1);            \
+         edge_ = edge_->next)
+
+/* One search loop, instantiated per option combination. PARENTS, STATS,
+ * STOP and LAZY are literals, so each instance carries only the work it
+ * needs and the inner loop tests no option at run time. The caller seeds
+ * the queue and initialises distances (and parents) before the call. */
+#define DIJKSTRA_KERNEL(name, GRAPH, FOR_EACH_EDGE, PARENTS, STATS, STOP,   \
+                        LAZY)                                               \
+static void name(GRAPH* graph, DijkstraSearch* search) {                    \
+    PriorityQueue* pq = search->pq;                                         \
+    int* distances = search->distances;                                     \
+    int* parents = search->parents;                                         \
+    long long settled = 0, relaxed = 0, decreased = 0;                      \
+    (void)parents;                                                          \
+                                                                            \
+    while (!is_empty(pq)) {                                                 \
+        PQNode current = extract_min(pq);                                   \
+        int neighbor, weight, parent;                                       \
+                                                                            \
+        if (current.vertex == -1 || current.distance == INF) {              \
+            break;                                                          \
+        }                                                                   \
+        if (STATS) settled++;                                               \
+        if ((STOP) == STOP_TARGET && current.vertex == search->target) {    \
+            break;                                                          \
+        }                                                                   \
+        if ((STOP) == STOP_TARGETS && search->is_target[current.vertex] &&  \
+            --search->remaining == 0) {                                     \
+            break;                                                          \
+        }                                                                   \
+                                                                            \
+        FOR_EACH_EDGE(graph, current.vertex, neighbor, weight, parent) {    \
+            int new_distance = current.distance + weight;                   \
+            (void)parent;                                                   \
+                                                                            \
+            if (STATS) relaxed++;                                           \
+            DIJKSTRA_RELAX(pq, distances, parents, neighbor, new_distance,  \
+                           parent, PARENTS, LAZY, decreased++);             \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    if (STATS) {                                                            \
+        search->stats->vertices_settled = settled;                          \
+        search->stats->edges_relaxed = relaxed;                             \
+        search->stats->decrease_keys = decreased;                           \
+    }                                                                       \
+}
+
+bool dijkstra_search(Graph* graph, DijkstraSearch* search);
+
+#endif
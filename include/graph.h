@@ -14,16 +14,28 @@ typedef struct Edge {
     struct Edge* next;
 } Edge;
 
+typedef struct EdgeChunk {
+    struct EdgeChunk* next;
+    int capacity;
+    int used;
+    Edge edges[];
+} EdgeChunk;
+
 typedef struct Graph {
     int num_vertices;
     Edge** adjacency_list;
     int* vertex_degrees;
+    EdgeChunk* edge_chunks;
+    unsigned int version;
 } Graph;
 
 Graph* create_graph(int num_vertices);
 void destroy_graph(Graph* graph);
+Graph* copy_graph(Graph* graph);
 void add_edge(Graph* graph, int source, int destination, int weight);
+bool set_edge_weight(Graph* graph, int source, int destination, int weight);
 void print_graph(Graph* graph);
 bool is_valid_vertex(Graph* graph, int vertex);
+size_t graph_memory_usage(Graph* graph);
 
 #endif
\ No newline at end of file
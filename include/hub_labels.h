@@ -0,0 +1,42 @@
+#ifndef HUB_LABELS_H
+#define HUB_LABELS_H
+
+#include "graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct LabelSet {
+    int* offsets;
+    int* hubs;
+    int* distances;
+    uint32_t* byte_offsets;
+    uint8_t* packed;
+} LabelSet;
+
+typedef struct HubLabels {
+    int num_vertices;
+    int* order;
+    LabelSet out_labels;
+    LabelSet in_labels;
+    bool compressed;
+} HubLabels;
+
+typedef struct HubLabelStats {
+    double build_time_ms;
+    double average_label_size;
+    double bytes_per_vertex;
+    double query_time_ns;
+} HubLabelStats;
+
+HubLabels* build_hub_labels(Graph* graph, const int* order, HubLabelStats* stats);
+void destroy_hub_labels(HubLabels* labels);
+int hub_label_query(const HubLabels* labels, int source, int target);
+size_t hub_labels_memory_usage(const HubLabels* labels);
+bool compress_hub_labels(HubLabels* labels);
+bool expand_hub_labels(HubLabels* labels);
+bool save_hub_labels(const HubLabels* labels, const char* filename);
+HubLabels* load_hub_labels(const char* filename);
+
+#endif
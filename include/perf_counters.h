@@ -0,0 +1,52 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+typedef enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_EVENT_COUNT
+} PerfEvent;
+
+typedef struct PerfCounters {
+    int fds[PERF_EVENT_COUNT];
+    int leader;
+    int group_size;
+    PerfEvent group_order[PERF_EVENT_COUNT];
+} PerfCounters;
+
+typedef struct PerfSample {
+    unsigned long long values[PERF_EVENT_COUNT];
+    bool valid[PERF_EVENT_COUNT];
+} PerfSample;
+
+typedef struct PerfReport {
+    int queries;
+    long long edges_relaxed;
+    double elapsed_ms;
+    PerfSample totals;
+} PerfReport;
+
+typedef DijkstraResult (*DijkstraEngine)(void* context, int source,
+                                        DijkstraStats* stats);
+
+bool perf_counters_open(PerfCounters* counters);
+void perf_counters_close(PerfCounters* counters);
+void perf_counters_start(PerfCounters* counters);
+PerfSample perf_counters_stop(PerfCounters* counters);
+const char* perf_event_name(PerfEvent event);
+bool profile_engine(PerfCounters* counters, DijkstraEngine engine, void* context,
+                    Graph* graph, const int* sources, int num_sources,
+                    PerfReport* report);
+void print_perf_report(const char* name, const PerfReport* report);
+
+#endif
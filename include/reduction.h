@@ -0,0 +1,38 @@
+#ifndef REDUCTION_H
+#define REDUCTION_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+typedef struct ReducedGraph {
+    Graph* original;
+    int num_vertices;
+    int num_core;
+    int num_chains;
+    int num_pruned;
+    int* core_index;
+    int* core_vertices;
+    int* core_offsets;
+    int* core_targets;
+    int* core_weights;
+    int* core_via;
+    int* chain_of;
+    int* chain_position;
+    int* chain_offsets;
+    int* chain_vertices;
+    int* chain_ends;
+    int* chain_forward;
+    int* chain_backward;
+    int* pruned_order;
+    int* pruned_parent;
+    int* pruned_weight;
+} ReducedGraph;
+
+ReducedGraph* reduce_graph(Graph* graph);
+void destroy_reduced_graph(ReducedGraph* reduced);
+DijkstraResult dijkstra_reduced(ReducedGraph* reduced, int source);
+
+#endif
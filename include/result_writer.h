@@ -0,0 +1,36 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define RESULT_WRITER_BUFFER 65536
+
+typedef enum ResultFormat {
+    RESULT_TEXT,
+    RESULT_JSON_LINES,
+    RESULT_BINARY
+} ResultFormat;
+
+typedef struct ResultWriter {
+    FILE* stream;
+    char* buffer;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} ResultWriter;
+
+ResultWriter* create_result_writer(FILE* stream, size_t capacity);
+bool destroy_result_writer(ResultWriter* writer);
+bool flush_result_writer(ResultWriter* writer);
+void writer_put(ResultWriter* writer, const char* data, size_t length);
+void writer_put_int(ResultWriter* writer, int value);
+int format_int(char* out, int value);
+bool write_result_tree(ResultWriter* writer, DijkstraResult result,
+                       int num_vertices, int source, ResultFormat format);
+DijkstraResult read_result_binary(FILE* stream, int* num_vertices, int* source);
+
+#endif
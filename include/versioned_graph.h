@@ -0,0 +1,45 @@
+#ifndef VERSIONED_GRAPH_H
+#define VERSIONED_GRAPH_H
+
+#include "graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#define MAX_READERS 64
+
+typedef struct GraphVersion {
+    Graph* graph;
+    unsigned long version;
+    unsigned long retired_epoch;
+    struct GraphVersion* next_retired;
+} GraphVersion;
+
+typedef struct ReaderSlot {
+    unsigned long epoch;
+    int in_use;
+    char padding[64 - sizeof(unsigned long) - sizeof(int)];
+} ReaderSlot;
+
+typedef struct VersionedGraph {
+    GraphVersion* current;
+    unsigned long global_epoch;
+    ReaderSlot readers[MAX_READERS];
+    GraphVersion* retired;
+    pthread_mutex_t writer_lock;
+} VersionedGraph;
+
+VersionedGraph* create_versioned_graph(Graph* initial);
+void destroy_versioned_graph(VersionedGraph* versioned);
+int register_reader(VersionedGraph* versioned);
+void unregister_reader(VersionedGraph* versioned, int reader);
+Graph* acquire_snapshot(VersionedGraph* versioned, int reader);
+void release_snapshot(VersionedGraph* versioned, int reader);
+Graph* begin_update(VersionedGraph* versioned);
+bool publish_update(VersionedGraph* versioned, Graph* next);
+void abort_update(VersionedGraph* versioned, Graph* next);
+unsigned long current_version(VersionedGraph* versioned);
+int reclaim_versions(VersionedGraph* versioned);
+
+#endif
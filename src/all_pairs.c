@@ -0,0 +1,605 @@
+#include "../include/all_pairs.h"
+#include "../include/priority_queue.h"
+#include "../include/dijkstra_kernel.h"
+#include "../include/allocator.h"
+#include <pthread.h>
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define ALL_PAIRS_MAGIC 0x42545041
+#define ALL_PAIRS_VERSION 2
+
+typedef struct AllPairsContext {
+    Graph* graph;
+    AllPairsTable* table;
+    int next_source;
+    int next_worker;
+    pthread_t owner;
+    bool failed;
+    pthread_mutex_t lock;
+} AllPairsContext;
+
+static AllPairsTable* create_table(int num_vertices, bool with_paths) {
+    AllPairsTable* table = calloc(1, sizeof(AllPairsTable));
+    if (!table) {
+        return NULL;
+    }
+
+    table->num_vertices = num_vertices;
+    table->stride = (num_vertices + ALL_PAIRS_BLOCK - 1) /
+                    ALL_PAIRS_BLOCK * ALL_PAIRS_BLOCK;
+
+    size_t cells = (size_t)table->stride * table->stride;
+    table->distances = policy_alloc(cells * sizeof(int));
+    if (with_paths) {
+        table->predecessors = policy_alloc(cells * sizeof(int));
+    }
+
+    if (!table->distances || (with_paths && !table->predecessors)) {
+        destroy_all_pairs(table);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < cells; i++) {
+        table->distances[i] = INF;
+    }
+    if (table->predecessors) {
+        for (size_t i = 0; i < cells; i++) {
+            table->predecessors[i] = -1;
+        }
+    }
+
+    return table;
+}
+
+void destroy_all_pairs(AllPairsTable* table) {
+    if (!table) return;
+
+    policy_free(table->distances);
+    policy_free(table->predecessors);
+    free(table);
+}
+
+/* Relaxes block (ib, jb) through the intermediate vertices of block kb.
+ * INF + INF stays below INT_MAX and any sum with an INF term is at least
+ * INF, so the minimum needs no reachability test per element. */
+static void update_block(AllPairsTable* table, int* pred, int ib, int jb, int kb) {
+    int stride = table->stride;
+    int* d = table->distances;
+
+    for (int k = kb; k < kb + ALL_PAIRS_BLOCK; k++) {
+        const int* row_k = d + (size_t)k * stride + jb;
+        const int* pred_k = pred ? pred + (size_t)k * stride + jb : NULL;
+
+        for (int i = ib; i < ib + ALL_PAIRS_BLOCK; i++) {
+            int dik = d[(size_t)i * stride + k];
+            if (dik == INF) continue;
+
+            int* row_i = d + (size_t)i * stride + jb;
+            int* pred_i = pred ? pred + (size_t)i * stride + jb : NULL;
+
+#if defined(__SSE2__)
+            __m128i through = _mm_set1_epi32(dik);
+
+            for (int j = 0; j < ALL_PAIRS_BLOCK; j += 4) {
+                __m128i current = _mm_loadu_si128((const __m128i*)(row_i + j));
+                __m128i candidate = _mm_add_epi32(
+                    through, _mm_loadu_si128((const __m128i*)(row_k + j)));
+                __m128i smaller = _mm_cmplt_epi32(candidate, current);
+
+                _mm_storeu_si128((__m128i*)(row_i + j),
+                                 _mm_or_si128(_mm_and_si128(smaller, candidate),
+                                              _mm_andnot_si128(smaller, current)));
+                if (pred_i) {
+                    __m128i old = _mm_loadu_si128((const __m128i*)(pred_i + j));
+                    __m128i via = _mm_loadu_si128((const __m128i*)(pred_k + j));
+                    _mm_storeu_si128((__m128i*)(pred_i + j),
+                                     _mm_or_si128(_mm_and_si128(smaller, via),
+                                                  _mm_andnot_si128(smaller, old)));
+                }
+            }
+#else
+            for (int j = 0; j < ALL_PAIRS_BLOCK; j++) {
+                int candidate = dik + row_k[j];
+                if (candidate < row_i[j]) {
+                    row_i[j] = candidate;
+                    if (pred_i) {
+                        pred_i[j] = pred_k[j];
+                    }
+                }
+            }
+#endif
+        }
+    }
+}
+
+/* Phase-three kernels: the pivot row and column blocks are final, so each
+ * row of block (ib, jb) can take every pivot while held in registers. */
+static void update_outer_block(AllPairsTable* table, int ib, int jb, int kb) {
+    int stride = table->stride;
+    int* d = table->distances;
+
+    for (int i = ib; i < ib + ALL_PAIRS_BLOCK; i++) {
+        const int* row_ik = d + (size_t)i * stride + kb;
+        int* row_i = d + (size_t)i * stride + jb;
+
+#if defined(__SSE2__)
+        __m128i best[ALL_PAIRS_BLOCK / 4];
+
+        for (int j = 0; j < ALL_PAIRS_BLOCK / 4; j++) {
+            best[j] = _mm_loadu_si128((const __m128i*)(row_i + 4 * j));
+        }
+
+        for (int k = 0; k < ALL_PAIRS_BLOCK; k++) {
+            int dik = row_ik[k];
+            if (dik == INF) continue;
+
+            const int* row_k = d + (size_t)(kb + k) * stride + jb;
+            __m128i through = _mm_set1_epi32(dik);
+
+            for (int j = 0; j < ALL_PAIRS_BLOCK / 4; j++) {
+                __m128i candidate = _mm_add_epi32(
+                    through, _mm_loadu_si128((const __m128i*)(row_k + 4 * j)));
+                __m128i smaller = _mm_cmplt_epi32(candidate, best[j]);
+                best[j] = _mm_or_si128(_mm_and_si128(smaller, candidate),
+                                       _mm_andnot_si128(smaller, best[j]));
+            }
+        }
+
+        for (int j = 0; j < ALL_PAIRS_BLOCK / 4; j++) {
+            _mm_storeu_si128((__m128i*)(row_i + 4 * j), best[j]);
+        }
+#else
+        int best[ALL_PAIRS_BLOCK];
+        memcpy(best, row_i, sizeof(best));
+
+        for (int k = 0; k < ALL_PAIRS_BLOCK; k++) {
+            int dik = row_ik[k];
+            if (dik == INF) continue;
+
+            const int* row_k = d + (size_t)(kb + k) * stride + jb;
+            for (int j = 0; j < ALL_PAIRS_BLOCK; j++) {
+                int candidate = dik + row_k[j];
+                best[j] = candidate < best[j] ? candidate : best[j];
+            }
+        }
+
+        memcpy(row_i, best, sizeof(best));
+#endif
+    }
+}
+
+static void update_outer_block_paths(AllPairsTable* table, int* pred,
+                                     int ib, int jb, int kb) {
+    int stride = table->stride;
+    int* d = table->distances;
+
+    for (int i = ib; i < ib + ALL_PAIRS_BLOCK; i++) {
+        const int* row_ik = d + (size_t)i * stride + kb;
+        int* row_i = d + (size_t)i * stride + jb;
+        int* pred_i = pred + (size_t)i * stride + jb;
+
+#if defined(__SSE2__)
+        __m128i best[ALL_PAIRS_BLOCK / 4];
+        __m128i preds[ALL_PAIRS_BLOCK / 4];
+
+        for (int j = 0; j < ALL_PAIRS_BLOCK / 4; j++) {
+            best[j] = _mm_loadu_si128((const __m128i*)(row_i + 4 * j));
+            preds[j] = _mm_loadu_si128((const __m128i*)(pred_i + 4 * j));
+        }
+
+        for (int k = 0; k < ALL_PAIRS_BLOCK; k++) {
+            int dik = row_ik[k];
+            if (dik == INF) continue;
+
+            const int* row_k = d + (size_t)(kb + k) * stride + jb;
+            const int* pred_k = pred + (size_t)(kb + k) * stride + jb;
+            __m128i through = _mm_set1_epi32(dik);
+
+            for (int j = 0; j < ALL_PAIRS_BLOCK / 4; j++) {
+                __m128i candidate = _mm_add_epi32(
+                    through, _mm_loadu_si128((const __m128i*)(row_k + 4 * j)));
+                __m128i via = _mm_loadu_si128((const __m128i*)(pred_k + 4 * j));
+                __m128i smaller = _mm_cmplt_epi32(candidate, best[j]);
+                best[j] = _mm_or_si128(_mm_and_si128(smaller, candidate),
+                                       _mm_andnot_si128(smaller, best[j]));
+                preds[j] = _mm_or_si128(_mm_and_si128(smaller, via),
+                                        _mm_andnot_si128(smaller, preds[j]));
+            }
+        }
+
+        for (int j = 0; j < ALL_PAIRS_BLOCK / 4; j++) {
+            _mm_storeu_si128((__m128i*)(row_i + 4 * j), best[j]);
+            _mm_storeu_si128((__m128i*)(pred_i + 4 * j), preds[j]);
+        }
+#else
+        int best[ALL_PAIRS_BLOCK];
+        int preds[ALL_PAIRS_BLOCK];
+
+        memcpy(best, row_i, sizeof(best));
+        memcpy(preds, pred_i, sizeof(preds));
+
+        for (int k = 0; k < ALL_PAIRS_BLOCK; k++) {
+            int dik = row_ik[k];
+            if (dik == INF) continue;
+
+            const int* row_k = d + (size_t)(kb + k) * stride + jb;
+            const int* pred_k = pred + (size_t)(kb + k) * stride + jb;
+
+            for (int j = 0; j < ALL_PAIRS_BLOCK; j++) {
+                int candidate = dik + row_k[j];
+                if (candidate < best[j]) {
+                    best[j] = candidate;
+                    preds[j] = pred_k[j];
+                }
+            }
+        }
+
+        memcpy(row_i, best, sizeof(best));
+        memcpy(pred_i, preds, sizeof(preds));
+#endif
+    }
+}
+
+/* Three-phase blocked Floyd-Warshall: for each pivot block, the diagonal
+ * block first, then its row and column, then every remaining block. pred
+ * is the predecessor matrix to maintain alongside, or NULL. */
+static void floyd_warshall(AllPairsTable* table, Graph* graph, int* pred) {
+    int n = table->num_vertices;
+    int stride = table->stride;
+
+    for (int u = 0; u < n; u++) {
+        table->distances[(size_t)u * stride + u] = 0;
+
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            size_t cell = (size_t)u * stride + edge->destination;
+            if (edge->weight < table->distances[cell]) {
+                table->distances[cell] = edge->weight;
+                if (pred) {
+                    pred[cell] = u;
+                }
+            }
+        }
+    }
+
+    for (int kb = 0; kb < stride; kb += ALL_PAIRS_BLOCK) {
+        update_block(table, pred, kb, kb, kb);
+
+        for (int b = 0; b < stride; b += ALL_PAIRS_BLOCK) {
+            if (b == kb) continue;
+            update_block(table, pred, kb, b, kb);
+            update_block(table, pred, b, kb, kb);
+        }
+
+        for (int ib = 0; ib < stride; ib += ALL_PAIRS_BLOCK) {
+            if (ib == kb) continue;
+            for (int jb = 0; jb < stride; jb += ALL_PAIRS_BLOCK) {
+                if (jb == kb) continue;
+                if (pred) {
+                    update_outer_block_paths(table, pred, ib, jb, kb);
+                } else {
+                    update_outer_block(table, ib, jb, kb);
+                }
+            }
+        }
+    }
+}
+
+static bool has_zero_weight(Graph* graph) {
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            if (edge->weight == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* With positive weights every predecessor the blocked kernels record is
+ * strictly closer to the source, so each row is a tree. Zero-weight ties
+ * break that: phase three applies pivot rows that already hold later
+ * pivots, and a row can end up with a zero-weight predecessor cycle. For
+ * such graphs the rows are rebuilt as breadth-first trees over the tight
+ * edges (d[s][u] + w == d[s][v]), which claim every vertex exactly once. */
+static bool tight_edge_predecessors(AllPairsTable* table, Graph* graph) {
+    int n = table->num_vertices;
+    int* queue = malloc(n * sizeof(int));
+    if (!queue) {
+        return false;
+    }
+
+    for (int source = 0; source < n; source++) {
+        const int* distances = table->distances + (size_t)source * table->stride;
+        int* pred = table->predecessors + (size_t)source * table->stride;
+        int head = 0, tail = 0;
+
+        queue[tail++] = source;
+        while (head < tail) {
+            int u = queue[head++];
+
+            for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+                int v = edge->destination;
+                if (v != source && pred[v] == -1 &&
+                    distances[u] + edge->weight == distances[v]) {
+                    pred[v] = u;
+                    queue[tail++] = v;
+                }
+            }
+        }
+    }
+
+    free(queue);
+    return true;
+}
+
+/* The parents of one search form a shortest-path tree, so they are stored
+ * as the predecessor row of the source as they are. */
+static void search_row(Graph* graph, AllPairsTable* table, int source,
+                       PriorityQueue* pq) {
+    DijkstraSearch search = {pq, NULL, NULL, -1, NULL, 0, true, NULL};
+
+    search.distances = table->distances + (size_t)source * table->stride;
+    if (table->predecessors) {
+        search.parents = table->predecessors + (size_t)source * table->stride;
+    }
+
+    search.distances[source] = 0;
+    insert(pq, source, 0);
+    dijkstra_search(graph, &search);
+}
+
+static void* all_pairs_worker(void* arg) {
+    AllPairsContext* context = arg;
+    int n = context->graph->num_vertices;
+
+    pthread_mutex_lock(&context->lock);
+    int worker = context->next_worker++;
+    pthread_mutex_unlock(&context->lock);
+
+    if (!pthread_equal(pthread_self(), context->owner)) {
+        pin_worker_thread(worker);
+    }
+
+    PriorityQueue* pq = create_priority_queue(n);
+
+    if (!pq) {
+        pthread_mutex_lock(&context->lock);
+        context->failed = true;
+        pthread_mutex_unlock(&context->lock);
+        return NULL;
+    }
+
+    while (1) {
+        pthread_mutex_lock(&context->lock);
+        int source = context->next_source++;
+        pthread_mutex_unlock(&context->lock);
+
+        if (source >= n) {
+            break;
+        }
+
+        search_row(context->graph, context->table, source, pq);
+    }
+
+    destroy_priority_queue(pq);
+    return NULL;
+}
+
+static bool repeated_dijkstra(AllPairsTable* table, Graph* graph,
+                              int num_threads) {
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    if (!threads) {
+        return false;
+    }
+
+    AllPairsContext context;
+    context.graph = graph;
+    context.table = table;
+    context.next_source = 0;
+    context.next_worker = 0;
+    context.owner = pthread_self();
+    context.failed = false;
+    pthread_mutex_init(&context.lock, NULL);
+
+    int started = 0;
+    for (int t = 1; t < num_threads; t++) {
+        if (pthread_create(&threads[started], NULL, all_pairs_worker,
+                           &context) == 0) {
+            started++;
+        }
+    }
+
+    all_pairs_worker(&context);
+
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    pthread_mutex_destroy(&context.lock);
+    free(threads);
+    return !context.failed;
+}
+
+/* Floyd-Warshall does a fixed n^3 of cheap vector work; repeated Dijkstra
+ * costs roughly n * (m + n log n) heap-bound steps. On 1000-vertex random
+ * graphs the two meet at about n / 8 edges per vertex. */
+AllPairsMethod choose_all_pairs_method(Graph* graph) {
+    if (!graph) {
+        return ALL_PAIRS_DIJKSTRA;
+    }
+
+    long long n = graph->num_vertices;
+    long long m = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        m += graph->vertex_degrees[u];
+    }
+
+    return m * 8 >= n * n ? ALL_PAIRS_FLOYD_WARSHALL : ALL_PAIRS_DIJKSTRA;
+}
+
+AllPairsTable* build_all_pairs(Graph* graph, AllPairsMethod method,
+                               bool with_paths, int num_threads) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    if (num_threads < 1) {
+        num_threads = 1;
+    }
+
+    if (method == ALL_PAIRS_AUTO) {
+        method = choose_all_pairs_method(graph);
+    }
+
+    AllPairsTable* table = create_table(graph->num_vertices, with_paths);
+    if (!table) {
+        printf("Error: Memory allocation failed for all-pairs table\n");
+        return NULL;
+    }
+    table->method = method;
+
+    bool ok;
+    if (method == ALL_PAIRS_FLOYD_WARSHALL) {
+        bool rebuild = table->predecessors && has_zero_weight(graph);
+
+        floyd_warshall(table, graph, rebuild ? NULL : table->predecessors);
+        ok = !rebuild || tight_edge_predecessors(table, graph);
+    } else {
+        ok = repeated_dijkstra(table, graph, num_threads);
+    }
+
+    if (!ok) {
+        printf("Error: Memory allocation failed during all-pairs search\n");
+        destroy_all_pairs(table);
+        return NULL;
+    }
+
+    return table;
+}
+
+int all_pairs_distance(const AllPairsTable* table, int source, int target) {
+    if (!table || source < 0 || source >= table->num_vertices ||
+        target < 0 || target >= table->num_vertices) {
+        return INF;
+    }
+
+    return table->distances[(size_t)source * table->stride + target];
+}
+
+/* Walks the predecessor row of the source backwards from the target, so
+ * every step stays within one shortest-path tree. */
+int all_pairs_path(const AllPairsTable* table, int source, int target,
+                   int* path, int max_length) {
+    if (!table || !table->predecessors || !path || max_length <= 0 ||
+        all_pairs_distance(table, source, target) == INF) {
+        return -1;
+    }
+
+    const int* pred = table->predecessors + (size_t)source * table->stride;
+    int length = 1;
+
+    for (int v = target; v != source; v = pred[v]) {
+        if (pred[v] < 0 || length == max_length ||
+            length == table->num_vertices) {
+            return -1;
+        }
+        length++;
+    }
+
+    int position = length;
+    for (int v = target; position > 0; v = pred[v]) {
+        path[--position] = v;
+    }
+
+    return length;
+}
+
+static bool write_ints(FILE* file, const int* values, size_t count) {
+    return fwrite(values, sizeof(int), count, file) == count;
+}
+
+static bool read_ints(FILE* file, int* values, size_t count) {
+    return fread(values, sizeof(int), count, file) == count;
+}
+
+bool save_all_pairs(const AllPairsTable* table, const char* filename) {
+    if (!table || !filename) {
+        printf("Error: Invalid input for saving all-pairs table\n");
+        return false;
+    }
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error: Cannot open %s for writing\n", filename);
+        return false;
+    }
+
+    int n = table->num_vertices;
+    int header[5] = {ALL_PAIRS_MAGIC, ALL_PAIRS_VERSION, n,
+                     table->predecessors != NULL, table->method};
+    bool ok = write_ints(file, header, 5);
+
+    for (int u = 0; u < n && ok; u++) {
+        ok = write_ints(file, table->distances + (size_t)u * table->stride, n);
+    }
+    for (int u = 0; u < n && ok && table->predecessors; u++) {
+        ok = write_ints(file, table->predecessors + (size_t)u * table->stride, n);
+    }
+
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+
+    if (!ok) {
+        printf("Error: Failed to write all-pairs table to %s\n", filename);
+    }
+    return ok;
+}
+
+AllPairsTable* load_all_pairs(const char* filename) {
+    if (!filename) {
+        printf("Error: Filename is NULL\n");
+        return NULL;
+    }
+
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        printf("Error: Cannot open %s for reading\n", filename);
+        return NULL;
+    }
+
+    int header[5];
+    if (!read_ints(file, header, 5) || header[0] != ALL_PAIRS_MAGIC ||
+        header[1] != ALL_PAIRS_VERSION || header[2] <= 0) {
+        printf("Error: %s is not an all-pairs table file\n", filename);
+        fclose(file);
+        return NULL;
+    }
+
+    int n = header[2];
+    AllPairsTable* table = create_table(n, header[3] != 0);
+    bool ok = table != NULL;
+
+    if (ok) {
+        table->method = (AllPairsMethod)header[4];
+    }
+    for (int u = 0; u < n && ok; u++) {
+        ok = read_ints(file, table->distances + (size_t)u * table->stride, n);
+    }
+    for (int u = 0; u < n && ok && table->predecessors; u++) {
+        ok = read_ints(file, table->predecessors + (size_t)u * table->stride, n);
+    }
+
+    fclose(file);
+
+    if (!ok) {
+        printf("Error: Failed to read all-pairs table from %s\n", filename);
+        destroy_all_pairs(table);
+        return NULL;
+    }
+    return table;
+}
@@ -0,0 +1,350 @@
+#define _GNU_SOURCE
+
+#include "../include/allocator.h"
+#include <string.h>
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define ALLOC_HEADER_SIZE 64
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define ALLOC_HUGE_THRESHOLD (HUGE_PAGE_SIZE / 2)
+#define NODE_PATH "/sys/devices/system/node"
+
+#define MPOL_MODE_BIND 2
+#define MPOL_MODE_INTERLEAVE 3
+#define MPOL_MODE_LOCAL 4
+
+typedef enum AllocKind {
+    ALLOC_HEAP,
+    ALLOC_MAPPED
+} AllocKind;
+
+typedef struct AllocHeader {
+    void* base;
+    size_t mapped_size;
+    AllocKind kind;
+} AllocHeader;
+
+static AllocPolicy current_policy = {PAGES_DEFAULT, NUMA_DEFAULT, 0};
+
+void set_alloc_policy(AllocPolicy policy) {
+    current_policy = policy;
+}
+
+AllocPolicy get_alloc_policy(void) {
+    return current_policy;
+}
+
+static int parse_range_list(const char* text, bool* members, int capacity) {
+    int highest = -1;
+
+    while (*text) {
+        char* end;
+        long first = strtol(text, &end, 10);
+        if (end == text) {
+            break;
+        }
+
+        long last = first;
+        text = end;
+        if (*text == '-') {
+            last = strtol(text + 1, &end, 10);
+            text = end;
+        }
+
+        for (long i = first; i <= last && i < capacity; i++) {
+            if (members) {
+                members[i] = true;
+            }
+            if (i > highest) {
+                highest = (int)i;
+            }
+        }
+
+        while (*text == ',' || *text == '\n' || *text == ' ') {
+            text++;
+        }
+    }
+
+    return highest + 1;
+}
+
+static bool read_sysfs(const char* path, char* buffer, size_t size) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    size_t length = fread(buffer, 1, size - 1, file);
+    buffer[length] = '\0';
+    fclose(file);
+    return length > 0;
+}
+
+int numa_node_count(void) {
+    char buffer[256];
+
+    if (!read_sysfs(NODE_PATH "/online", buffer, sizeof(buffer))) {
+        return 1;
+    }
+
+    int count = parse_range_list(buffer, NULL, ALLOC_MAX_NUMA_NODES);
+    return count > 0 ? count : 1;
+}
+
+bool pin_thread_to_node(int node) {
+#if defined(__linux__)
+    char path[128];
+    char buffer[4096];
+    bool cpus[CPU_SETSIZE] = {false};
+
+    snprintf(path, sizeof(path), NODE_PATH "/node%d/cpulist", node);
+    if (node < 0 || !read_sysfs(path, buffer, sizeof(buffer))) {
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    int count = parse_range_list(buffer, cpus, CPU_SETSIZE);
+    for (int cpu = 0; cpu < count; cpu++) {
+        if (cpus[cpu]) {
+            CPU_SET(cpu, &set);
+        }
+    }
+
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+/* Spreads spawned workers across NUMA nodes when a placement policy is
+ * active, so their search state is first-touched on the node they run on. */
+bool pin_worker_thread(int worker) {
+    if (current_policy.placement == NUMA_DEFAULT || worker < 0) {
+        return false;
+    }
+
+    return pin_thread_to_node(worker % numa_node_count());
+}
+
+#if defined(__linux__)
+static size_t round_up(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+static void* map_huge_aligned(size_t length) {
+    size_t padded = length + HUGE_PAGE_SIZE;
+    char* raw = mmap(NULL, padded, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return NULL;
+    }
+
+    char* aligned = (char*)round_up((size_t)raw, HUGE_PAGE_SIZE);
+    if (aligned > raw) {
+        munmap(raw, aligned - raw);
+    }
+    if (aligned + length < raw + padded) {
+        munmap(aligned + length, raw + padded - (aligned + length));
+    }
+
+#if defined(MADV_HUGEPAGE)
+    madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+
+static void* map_region(size_t size, PageMode pages, size_t* mapped_size) {
+    void* base = NULL;
+
+    if (pages == PAGES_DEFAULT) {
+        *mapped_size = round_up(size, (size_t)sysconf(_SC_PAGESIZE));
+        base = mmap(NULL, *mapped_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return base == MAP_FAILED ? NULL : base;
+    }
+
+    *mapped_size = round_up(size, HUGE_PAGE_SIZE);
+
+#if defined(MAP_HUGETLB)
+    /* Explicit huge pages need a reserved hugetlbfs pool; without one the
+     * mapping fails and we fall back to transparent huge pages. */
+    if (pages == PAGES_EXPLICIT_HUGE) {
+        base = mmap(NULL, *mapped_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED) {
+            return base;
+        }
+    }
+#endif
+
+    return map_huge_aligned(*mapped_size);
+}
+
+static void apply_placement(void* base, size_t length, AllocPolicy policy) {
+#if defined(SYS_mbind)
+    unsigned long mask[ALLOC_MAX_NUMA_NODES / (8 * sizeof(unsigned long))] = {0};
+    unsigned long bits = 8 * sizeof(unsigned long);
+    int nodes = numa_node_count();
+    int mode;
+
+    switch (policy.placement) {
+        case NUMA_LOCAL:
+            syscall(SYS_mbind, base, length, MPOL_MODE_LOCAL, NULL, 0, 0);
+            return;
+
+        case NUMA_INTERLEAVE:
+            if (nodes < 2) return;
+            for (int n = 0; n < nodes; n++) {
+                mask[n / bits] |= 1UL << (n % bits);
+            }
+            mode = MPOL_MODE_INTERLEAVE;
+            break;
+
+        case NUMA_BIND:
+            if (policy.node < 0 || policy.node >= nodes) return;
+            mask[policy.node / bits] |= 1UL << (policy.node % bits);
+            mode = MPOL_MODE_BIND;
+            break;
+
+        default:
+            return;
+    }
+
+    /* Placement is only a hint: on kernels without NUMA support the call
+     * fails and the memory simply stays where first touch puts it. */
+    syscall(SYS_mbind, base, length, mode, mask, ALLOC_MAX_NUMA_NODES + 1, 0);
+#else
+    (void)base;
+    (void)length;
+    (void)policy;
+#endif
+}
+#endif
+
+void* policy_alloc_with(size_t size, AllocPolicy policy) {
+    size_t total = size + ALLOC_HEADER_SIZE;
+    AllocHeader* header;
+
+#if defined(__linux__)
+    /* NUMA placement applies to every allocation, on base pages if need
+     * be. Huge pages are kept for allocations that fill a good part of
+     * one: a 2 MB mapping per small per-query array costs more in faults
+     * than the TLB reach it buys. */
+    if (size < ALLOC_HUGE_THRESHOLD) {
+        policy.pages = PAGES_DEFAULT;
+    }
+
+    if (policy.pages != PAGES_DEFAULT || policy.placement != NUMA_DEFAULT) {
+        size_t mapped_size;
+        void* base = map_region(total, policy.pages, &mapped_size);
+
+        if (base) {
+            apply_placement(base, mapped_size, policy);
+            header = base;
+            header->base = base;
+            header->mapped_size = mapped_size;
+            header->kind = ALLOC_MAPPED;
+            return (char*)base + ALLOC_HEADER_SIZE;
+        }
+    }
+#endif
+
+    void* base = malloc(total);
+    if (!base) {
+        return NULL;
+    }
+
+    header = base;
+    header->base = base;
+    header->mapped_size = 0;
+    header->kind = ALLOC_HEAP;
+    return (char*)base + ALLOC_HEADER_SIZE;
+}
+
+void* policy_alloc(size_t size) {
+    return policy_alloc_with(size, current_policy);
+}
+
+void policy_free(void* ptr) {
+    if (!ptr) return;
+
+    AllocHeader* header = (AllocHeader*)((char*)ptr - ALLOC_HEADER_SIZE);
+
+#if defined(__linux__)
+    if (header->kind == ALLOC_MAPPED) {
+        munmap(header->base, header->mapped_size);
+        return;
+    }
+#endif
+
+    free(header->base);
+}
+
+Graph* replicate_graph(Graph* graph, int node) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    AllocPolicy policy = current_policy;
+    policy.placement = NUMA_BIND;
+    policy.node = node;
+
+    int n = graph->num_vertices;
+    int num_edges = 0;
+    for (int i = 0; i < n; i++) {
+        num_edges += graph->vertex_degrees[i];
+    }
+
+    Graph* replica = malloc(sizeof(Graph));
+    if (!replica) {
+        printf("Error: Memory allocation failed for graph replica\n");
+        return NULL;
+    }
+
+    replica->num_vertices = n;
+    replica->adjacency_list = policy_alloc_with(n * sizeof(Edge*), policy);
+    replica->vertex_degrees = policy_alloc_with(n * sizeof(int), policy);
+    replica->edge_chunks = policy_alloc_with(
+        sizeof(EdgeChunk) + num_edges * sizeof(Edge), policy);
+    replica->version = graph->version;
+
+    if (!replica->adjacency_list || !replica->vertex_degrees ||
+        !replica->edge_chunks) {
+        printf("Error: Memory allocation failed for graph replica\n");
+        policy_free(replica->adjacency_list);
+        policy_free(replica->vertex_degrees);
+        policy_free(replica->edge_chunks);
+        free(replica);
+        return NULL;
+    }
+
+    replica->edge_chunks->next = NULL;
+    replica->edge_chunks->capacity = num_edges;
+    replica->edge_chunks->used = num_edges;
+
+    /* Each vertex's edges are copied into consecutive pool slots in list
+     * order, so a relaxation loop walks the replica sequentially. */
+    int used = 0;
+    for (int i = 0; i < n; i++) {
+        Edge** tail = &replica->adjacency_list[i];
+        for (Edge* edge = graph->adjacency_list[i]; edge; edge = edge->next) {
+            Edge* copy = &replica->edge_chunks->edges[used++];
+            copy->destination = edge->destination;
+            copy->weight = edge->weight;
+            *tail = copy;
+            tail = &copy->next;
+        }
+        *tail = NULL;
+        replica->vertex_degrees[i] = graph->vertex_degrees[i];
+    }
+
+    return replica;
+}
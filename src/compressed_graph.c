@@ -0,0 +1,353 @@
+#include "../include/compressed_graph.h"
+#include "../include/allocator.h"
+#include "../include/dijkstra_kernel.h"
+#include <string.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#define STREAM_PADDING 16
+#define WEIGHT_PADDING 8
+
+typedef struct EncodedEdge {
+    int destination;
+    int weight;
+} EncodedEdge;
+
+#if defined(__SSSE3__)
+static uint8_t shuffle_masks[256][16];
+static uint8_t group_lengths[256];
+static bool tables_ready = false;
+
+static void init_decode_tables(void) {
+    if (tables_ready) return;
+
+    for (int control = 0; control < 256; control++) {
+        int position = 0;
+        for (int k = 0; k < 4; k++) {
+            int length = ((control >> (2 * k)) & 3) + 1;
+            for (int b = 0; b < 4; b++) {
+                shuffle_masks[control][4 * k + b] =
+                    b < length ? (uint8_t)(position + b) : 0x80;
+            }
+            position += length;
+        }
+        group_lengths[control] = (uint8_t)position;
+    }
+
+    tables_ready = true;
+}
+#endif
+
+static int value_length(uint32_t value) {
+    if (value < (1u << 8)) return 1;
+    if (value < (1u << 16)) return 2;
+    if (value < (1u << 24)) return 3;
+    return 4;
+}
+
+static int compare_encoded_edges(const void* a, const void* b) {
+    const EncodedEdge* x = a;
+    const EncodedEdge* y = b;
+
+    if (x->destination != y->destination) {
+        return x->destination < y->destination ? -1 : 1;
+    }
+    return x->weight < y->weight ? -1 : (x->weight > y->weight);
+}
+
+static void write_bits(uint8_t* buffer, uint64_t bit, uint32_t value, int bits) {
+    for (int b = 0; b < bits; b++, bit++) {
+        if (value & (1u << b)) {
+            buffer[bit >> 3] |= (uint8_t)(1u << (bit & 7));
+        }
+    }
+}
+
+static uint32_t read_bits(const uint8_t* buffer, uint64_t bit, uint32_t mask) {
+    const uint8_t* p = buffer + (bit >> 3);
+    uint64_t word = 0;
+
+    for (int b = 0; b < 8; b++) {
+        word |= (uint64_t)p[b] << (8 * b);
+    }
+
+    return (uint32_t)(word >> (bit & 7)) & mask;
+}
+
+static const uint8_t* decode_group(const uint8_t* data, uint8_t control,
+                                   int count, uint32_t* out) {
+#if defined(__SSSE3__)
+    if (count == 4) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)data);
+        __m128i mask = _mm_loadu_si128((const __m128i*)shuffle_masks[control]);
+        _mm_storeu_si128((__m128i*)out, _mm_shuffle_epi8(bytes, mask));
+        return data + group_lengths[control];
+    }
+#endif
+
+    for (int k = 0; k < count; k++) {
+        int length = ((control >> (2 * k)) & 3) + 1;
+        uint32_t value = 0;
+        for (int b = 0; b < length; b++) {
+            value |= (uint32_t)data[b] << (8 * b);
+        }
+        out[k] = value;
+        data += length;
+    }
+
+    return data;
+}
+
+/* Neighbours are stored sorted and gap-encoded in stream-vbyte layout: for
+ * each vertex, one control byte per group of four gaps (2-bit byte
+ * lengths) followed by the gap bytes themselves. Weights live in a
+ * separate bit-packed array using the smallest width that fits. */
+CompressedGraph* compress_graph(Graph* graph) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    int n = graph->num_vertices;
+    int num_edges = 0;
+    int max_degree = 0;
+    int max_weight = 0;
+
+    for (int u = 0; u < n; u++) {
+        num_edges += graph->vertex_degrees[u];
+        if (graph->vertex_degrees[u] > max_degree) {
+            max_degree = graph->vertex_degrees[u];
+        }
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            if (edge->weight > max_weight) {
+                max_weight = edge->weight;
+            }
+        }
+    }
+
+    CompressedGraph* compressed = calloc(1, sizeof(CompressedGraph));
+    EncodedEdge* edges = malloc((max_degree + 1) * sizeof(EncodedEdge));
+    if (!compressed || !edges) {
+        printf("Error: Memory allocation failed for compressed graph\n");
+        free(compressed);
+        free(edges);
+        return NULL;
+    }
+
+    compressed->num_vertices = n;
+    compressed->num_edges = num_edges;
+    while (compressed->weight_bits < 31 &&
+           (max_weight >> compressed->weight_bits) != 0) {
+        compressed->weight_bits++;
+    }
+
+    compressed->edge_offsets = malloc((n + 1) * sizeof(uint32_t));
+    compressed->byte_offsets = malloc((n + 1) * sizeof(uint32_t));
+    if (!compressed->edge_offsets || !compressed->byte_offsets) {
+        printf("Error: Memory allocation failed for compressed graph\n");
+        free(edges);
+        destroy_compressed_graph(compressed);
+        return NULL;
+    }
+
+    compressed->edge_offsets[0] = 0;
+    compressed->byte_offsets[0] = 0;
+
+    for (int u = 0; u < n; u++) {
+        int degree = 0;
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            edges[degree].destination = edge->destination;
+            edges[degree].weight = edge->weight;
+            degree++;
+        }
+        qsort(edges, degree, sizeof(EncodedEdge), compare_encoded_edges);
+
+        uint32_t bytes = (degree + 3) / 4;
+        int previous = 0;
+        for (int i = 0; i < degree; i++) {
+            bytes += value_length(edges[i].destination - previous);
+            previous = edges[i].destination;
+        }
+
+        compressed->edge_offsets[u + 1] = compressed->edge_offsets[u] + degree;
+        compressed->byte_offsets[u + 1] = compressed->byte_offsets[u] + bytes;
+    }
+
+    uint64_t weight_bytes =
+        ((uint64_t)num_edges * compressed->weight_bits + 7) / 8;
+    compressed->adjacency = calloc(compressed->byte_offsets[n] + STREAM_PADDING, 1);
+    compressed->weights = calloc(weight_bytes + WEIGHT_PADDING, 1);
+    if (!compressed->adjacency || !compressed->weights) {
+        printf("Error: Memory allocation failed for compressed graph\n");
+        free(edges);
+        destroy_compressed_graph(compressed);
+        return NULL;
+    }
+
+    for (int u = 0; u < n; u++) {
+        int degree = 0;
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            edges[degree].destination = edge->destination;
+            edges[degree].weight = edge->weight;
+            degree++;
+        }
+        qsort(edges, degree, sizeof(EncodedEdge), compare_encoded_edges);
+
+        uint8_t* control = compressed->adjacency + compressed->byte_offsets[u];
+        uint8_t* data = control + (degree + 3) / 4;
+        uint64_t bit = (uint64_t)compressed->edge_offsets[u] *
+                       compressed->weight_bits;
+        int previous = 0;
+
+        for (int i = 0; i < degree; i++) {
+            uint32_t gap = edges[i].destination - previous;
+            int length = value_length(gap);
+
+            control[i / 4] |= (uint8_t)((length - 1) << (2 * (i % 4)));
+            for (int b = 0; b < length; b++) {
+                *data++ = (uint8_t)(gap >> (8 * b));
+            }
+
+            write_bits(compressed->weights, bit, edges[i].weight,
+                       compressed->weight_bits);
+            bit += compressed->weight_bits;
+            previous = edges[i].destination;
+        }
+    }
+
+#if defined(__SSSE3__)
+    init_decode_tables();
+#endif
+
+    free(edges);
+    return compressed;
+}
+
+void destroy_compressed_graph(CompressedGraph* graph) {
+    if (!graph) return;
+
+    free(graph->edge_offsets);
+    free(graph->byte_offsets);
+    free(graph->adjacency);
+    free(graph->weights);
+    free(graph);
+}
+
+size_t compressed_graph_memory_usage(const CompressedGraph* graph) {
+    if (!graph) return 0;
+
+    size_t n = graph->num_vertices;
+    size_t weight_bytes = ((size_t)graph->num_edges * graph->weight_bits + 7) / 8;
+
+    return sizeof(CompressedGraph) + 2 * (n + 1) * sizeof(uint32_t) +
+           graph->byte_offsets[n] + STREAM_PADDING +
+           weight_bytes + WEIGHT_PADDING;
+}
+
+/* Walks the out-edges of one vertex, decoding a group of four gaps at a
+ * time and reading each weight from the bit-packed array. */
+typedef struct EdgeCursor {
+    const uint8_t* control;
+    const uint8_t* data;
+    uint32_t gaps[4];
+    int index;
+    int count;
+    int left;
+    uint64_t bit;
+    uint32_t weight_mask;
+    uint32_t neighbor;
+} EdgeCursor;
+
+static EdgeCursor open_cursor(const CompressedGraph* graph, int u) {
+    EdgeCursor cursor;
+
+    cursor.control = graph->adjacency + graph->byte_offsets[u];
+    cursor.left = graph->edge_offsets[u + 1] - graph->edge_offsets[u];
+    cursor.data = cursor.control + (cursor.left + 3) / 4;
+    cursor.index = 0;
+    cursor.count = 0;
+    cursor.bit = (uint64_t)graph->edge_offsets[u] * graph->weight_bits;
+    cursor.weight_mask = (1u << graph->weight_bits) - 1;
+    cursor.neighbor = 0;
+    return cursor;
+}
+
+static bool next_edge(const CompressedGraph* graph, EdgeCursor* cursor,
+                      int* neighbor, int* weight) {
+    if (cursor->index == cursor->count) {
+        if (cursor->left == 0) {
+            return false;
+        }
+
+        cursor->count = cursor->left < 4 ? cursor->left : 4;
+        cursor->data = decode_group(cursor->data, *cursor->control++,
+                                    cursor->count, cursor->gaps);
+        cursor->left -= cursor->count;
+        cursor->index = 0;
+    }
+
+    cursor->neighbor += cursor->gaps[cursor->index++];
+    *neighbor = (int)cursor->neighbor;
+    *weight = (int)read_bits(graph->weights, cursor->bit, cursor->weight_mask);
+    cursor->bit += graph->weight_bits;
+    return true;
+}
+
+#define FOR_EACH_COMPRESSED_EDGE(graph, u, neighbor, weight, parent)        \
+    for (EdgeCursor cursor_ = open_cursor(graph, u);                        \
+         next_edge(graph, &cursor_, &(neighbor), &(weight)) &&              \
+         ((parent) = (u), 1);)
+
+DIJKSTRA_KERNEL(compressed_kernel, CompressedGraph, FOR_EACH_COMPRESSED_EDGE,
+                1, 0, STOP_NONE, 0)
+
+DijkstraResult dijkstra_compressed(CompressedGraph* graph, int source) {
+    DijkstraResult result = {NULL, NULL, false};
+
+    if (!graph || source < 0 || source >= graph->num_vertices) {
+        printf("Error: Invalid input for compressed Dijkstra\n");
+        return result;
+    }
+
+    int num_vertices = graph->num_vertices;
+
+    result.distances = policy_alloc(num_vertices * sizeof(int));
+    result.parents = policy_alloc(num_vertices * sizeof(int));
+
+    if (!result.distances || !result.parents) {
+        printf("Error: Memory allocation failed\n");
+        free_dijkstra_result(result);
+        result.distances = NULL;
+        result.parents = NULL;
+        return result;
+    }
+
+    PriorityQueue* pq = create_priority_queue(num_vertices);
+    if (!pq) {
+        printf("Error: Failed to create priority queue\n");
+        free_dijkstra_result(result);
+        result.distances = NULL;
+        result.parents = NULL;
+        return result;
+    }
+
+    for (int i = 0; i < num_vertices; i++) {
+        result.distances[i] = INF;
+        result.parents[i] = -1;
+    }
+
+    result.distances[source] = 0;
+
+    for (int i = 0; i < num_vertices; i++) {
+        insert(pq, i, result.distances[i]);
+    }
+
+    DijkstraSearch search = {pq, result.distances, result.parents, -1, NULL,
+                             0, false, NULL};
+    compressed_kernel(graph, &search);
+
+    destroy_priority_queue(pq);
+    result.success = true;
+    return result;
+}
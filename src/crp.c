@@ -0,0 +1,706 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/crp.h"
+#include "../include/priority_queue.h"
+#include "../include/allocator.h"
+#include <pthread.h>
+
+typedef struct CRPCustomizeContext {
+    CRPOverlay* overlay;
+    Graph* graph;
+    int level;
+    int next_cell;
+    int next_worker;
+    pthread_t owner;
+    bool failed;
+    pthread_mutex_t lock;
+} CRPCustomizeContext;
+
+static bool build_groups(int num_groups, const int* group_of, int n,
+                         const bool* include, int** offsets, int** items) {
+    *offsets = calloc(num_groups + 1, sizeof(int));
+    if (!*offsets) {
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        if (!include || include[v]) {
+            (*offsets)[group_of[v] + 1]++;
+        }
+    }
+    for (int g = 0; g < num_groups; g++) {
+        (*offsets)[g + 1] += (*offsets)[g];
+    }
+
+    *items = malloc(((*offsets)[num_groups] + 1) * sizeof(int));
+    int* fill = malloc((num_groups + 1) * sizeof(int));
+    if (!*items || !fill) {
+        free(fill);
+        return false;
+    }
+
+    for (int g = 0; g < num_groups; g++) {
+        fill[g] = (*offsets)[g];
+    }
+    for (int v = 0; v < n; v++) {
+        if (!include || include[v]) {
+            (*items)[fill[group_of[v]]++] = v;
+        }
+    }
+
+    free(fill);
+    return true;
+}
+
+static bool build_undirected(Graph* graph, int** offsets, int** neighbors) {
+    int n = graph->num_vertices;
+
+    *offsets = calloc(n + 1, sizeof(int));
+    if (!*offsets) {
+        return false;
+    }
+
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            (*offsets)[u + 1]++;
+            (*offsets)[edge->destination + 1]++;
+        }
+    }
+    for (int u = 0; u < n; u++) {
+        (*offsets)[u + 1] += (*offsets)[u];
+    }
+
+    *neighbors = malloc(((*offsets)[n] + 1) * sizeof(int));
+    int* fill = malloc(n * sizeof(int));
+    if (!*neighbors || !fill) {
+        free(fill);
+        return false;
+    }
+
+    for (int u = 0; u < n; u++) {
+        fill[u] = (*offsets)[u];
+    }
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            (*neighbors)[fill[u]++] = edge->destination;
+            (*neighbors)[fill[edge->destination]++] = u;
+        }
+    }
+
+    free(fill);
+    return true;
+}
+
+static int grow_base_cells(int n, const int* offsets, const int* neighbors,
+                           int max_size, int* cell, int* queue) {
+    int num_cells = 0;
+
+    for (int v = 0; v < n; v++) {
+        cell[v] = -1;
+    }
+
+    for (int seed = 0; seed < n; seed++) {
+        if (cell[seed] != -1) {
+            continue;
+        }
+
+        int id = num_cells++;
+        int head = 0, tail = 0, size = 1;
+        cell[seed] = id;
+        queue[tail++] = seed;
+
+        while (head < tail && size < max_size) {
+            int u = queue[head++];
+            for (int i = offsets[u]; i < offsets[u + 1] && size < max_size; i++) {
+                int w = neighbors[i];
+                if (cell[w] == -1) {
+                    cell[w] = id;
+                    queue[tail++] = w;
+                    size++;
+                }
+            }
+        }
+    }
+
+    return num_cells;
+}
+
+static int merge_cells(int n, const int* offsets, const int* neighbors,
+                       const CRPLevel* below, int max_size, int* cell,
+                       int* queue) {
+    int* group = malloc(below->num_cells * sizeof(int));
+    if (!group) {
+        return -1;
+    }
+
+    for (int c = 0; c < below->num_cells; c++) {
+        group[c] = -1;
+    }
+
+    int num_groups = 0;
+    for (int seed = 0; seed < below->num_cells; seed++) {
+        if (group[seed] != -1) {
+            continue;
+        }
+
+        int id = num_groups++;
+        int head = 0, tail = 0;
+        int size = below->member_offsets[seed + 1] - below->member_offsets[seed];
+        group[seed] = id;
+        queue[tail++] = seed;
+
+        while (head < tail) {
+            int c = queue[head++];
+            for (int m = below->member_offsets[c];
+                 m < below->member_offsets[c + 1]; m++) {
+                int u = below->members[m];
+                for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                    int other = below->cell[neighbors[i]];
+                    int other_size = below->member_offsets[other + 1] -
+                                     below->member_offsets[other];
+                    if (group[other] == -1 && size + other_size <= max_size) {
+                        group[other] = id;
+                        queue[tail++] = other;
+                        size += other_size;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int v = 0; v < n; v++) {
+        cell[v] = group[below->cell[v]];
+    }
+
+    free(group);
+    return num_groups;
+}
+
+static bool finalize_level(Graph* graph, CRPLevel* level,
+                           const CRPLevel* below) {
+    int n = graph->num_vertices;
+
+    if (!build_groups(level->num_cells, level->cell, n, NULL,
+                      &level->member_offsets, &level->members)) {
+        return false;
+    }
+
+    bool* is_boundary = calloc(n, sizeof(bool));
+    if (!is_boundary) {
+        return false;
+    }
+
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            if (level->cell[u] != level->cell[edge->destination]) {
+                is_boundary[u] = true;
+                is_boundary[edge->destination] = true;
+            }
+        }
+    }
+
+    bool ok = build_groups(level->num_cells, level->cell, n, is_boundary,
+                           &level->boundary_offsets, &level->boundary_vertices);
+    free(is_boundary);
+    if (!ok) {
+        return false;
+    }
+
+    level->boundary_index = malloc(n * sizeof(int));
+    level->clique_offsets = malloc((level->num_cells + 1) * sizeof(int));
+    if (!level->boundary_index || !level->clique_offsets) {
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        level->boundary_index[v] = -1;
+    }
+
+    level->clique_offsets[0] = 0;
+    for (int c = 0; c < level->num_cells; c++) {
+        int begin = level->boundary_offsets[c];
+        int count = level->boundary_offsets[c + 1] - begin;
+        for (int i = 0; i < count; i++) {
+            level->boundary_index[level->boundary_vertices[begin + i]] = i;
+        }
+        level->clique_offsets[c + 1] = level->clique_offsets[c] + count * count;
+    }
+
+    /* Customization of a cell searches the overlay one level down, so its
+     * search space is the lower level's boundary vertices inside the cell. */
+    if (!below) {
+        return build_groups(level->num_cells, level->cell, n, NULL,
+                            &level->node_offsets, &level->nodes);
+    }
+
+    bool* is_node = malloc(n * sizeof(bool));
+    if (!is_node) {
+        return false;
+    }
+    for (int v = 0; v < n; v++) {
+        is_node[v] = below->boundary_index[v] != -1;
+    }
+
+    ok = build_groups(level->num_cells, level->cell, n, is_node,
+                      &level->node_offsets, &level->nodes);
+    free(is_node);
+    return ok;
+}
+
+CRPPartition* crp_create_partition(Graph* graph, int num_levels,
+                                   const int* cell_sizes) {
+    if (!graph || !cell_sizes || num_levels <= 0 ||
+        num_levels > CRP_MAX_LEVELS) {
+        printf("Error: Invalid input for CRP partition\n");
+        return NULL;
+    }
+
+    for (int l = 0; l < num_levels; l++) {
+        if (cell_sizes[l] <= 0 || (l > 0 && cell_sizes[l] <= cell_sizes[l - 1])) {
+            printf("Error: Cell sizes must be positive and increasing\n");
+            return NULL;
+        }
+    }
+
+    CRPPartition* partition = calloc(1, sizeof(CRPPartition));
+    if (!partition) {
+        printf("Error: Memory allocation failed for CRP partition\n");
+        return NULL;
+    }
+
+    int n = graph->num_vertices;
+    partition->num_vertices = n;
+    partition->num_levels = num_levels;
+
+    int* offsets = NULL;
+    int* neighbors = NULL;
+    int* queue = malloc(n * sizeof(int));
+    bool ok = queue && build_undirected(graph, &offsets, &neighbors);
+
+    for (int l = 0; ok && l < num_levels; l++) {
+        CRPLevel* level = &partition->levels[l];
+        CRPLevel* below = l > 0 ? &partition->levels[l - 1] : NULL;
+
+        level->cell = malloc(n * sizeof(int));
+        if (!level->cell) {
+            ok = false;
+            break;
+        }
+
+        if (below) {
+            level->num_cells = merge_cells(n, offsets, neighbors, below,
+                                           cell_sizes[l], level->cell, queue);
+        } else {
+            level->num_cells = grow_base_cells(n, offsets, neighbors,
+                                               cell_sizes[l], level->cell, queue);
+        }
+
+        ok = level->num_cells > 0 && finalize_level(graph, level, below);
+    }
+
+    free(queue);
+    free(offsets);
+    free(neighbors);
+
+    if (!ok) {
+        printf("Error: Memory allocation failed for CRP partition\n");
+        crp_destroy_partition(partition);
+        return NULL;
+    }
+
+    return partition;
+}
+
+void crp_destroy_partition(CRPPartition* partition) {
+    if (!partition) return;
+
+    for (int l = 0; l < CRP_MAX_LEVELS; l++) {
+        CRPLevel* level = &partition->levels[l];
+        free(level->cell);
+        free(level->member_offsets);
+        free(level->members);
+        free(level->node_offsets);
+        free(level->nodes);
+        free(level->boundary_index);
+        free(level->boundary_offsets);
+        free(level->boundary_vertices);
+        free(level->clique_offsets);
+    }
+
+    free(partition);
+}
+
+CRPOverlay* crp_create_overlay(CRPPartition* partition) {
+    if (!partition) {
+        printf("Error: Partition is NULL\n");
+        return NULL;
+    }
+
+    CRPOverlay* overlay = calloc(1, sizeof(CRPOverlay));
+    if (!overlay) {
+        printf("Error: Memory allocation failed for CRP overlay\n");
+        return NULL;
+    }
+
+    overlay->partition = partition;
+
+    if (pthread_key_create(&overlay->query_key, NULL) != 0) {
+        printf("Error: Failed to create CRP query state key\n");
+        free(overlay);
+        return NULL;
+    }
+    pthread_mutex_init(&overlay->query_lock, NULL);
+
+    for (int l = 0; l < partition->num_levels; l++) {
+        CRPLevel* level = &partition->levels[l];
+        int size = level->clique_offsets[level->num_cells];
+
+        overlay->clique_weights[l] = malloc((size + 1) * sizeof(int));
+        if (!overlay->clique_weights[l]) {
+            printf("Error: Memory allocation failed for clique weights\n");
+            crp_destroy_overlay(overlay);
+            return NULL;
+        }
+    }
+
+    return overlay;
+}
+
+static void destroy_query_state(CRPQueryState* state) {
+    if (!state) return;
+
+    policy_free(state->distances);
+    policy_free(state->touched);
+    destroy_priority_queue(state->pq);
+    free(state);
+}
+
+void crp_destroy_overlay(CRPOverlay* overlay) {
+    if (!overlay) return;
+
+    for (int l = 0; l < CRP_MAX_LEVELS; l++) {
+        free(overlay->clique_weights[l]);
+    }
+
+    while (overlay->query_states) {
+        CRPQueryState* next = overlay->query_states->next;
+        destroy_query_state(overlay->query_states);
+        overlay->query_states = next;
+    }
+
+    pthread_key_delete(overlay->query_key);
+    pthread_mutex_destroy(&overlay->query_lock);
+    free(overlay);
+}
+
+/* touched, when given, collects every vertex whose distance leaves INF so
+ * a query can restore only those entries afterwards. */
+static void relax(PriorityQueue* pq, int* distances, int vertex,
+                  int new_distance, CRPQueryState* touched) {
+    if (new_distance >= distances[vertex]) {
+        return;
+    }
+
+    if (touched && distances[vertex] == INF) {
+        touched->touched[touched->num_touched++] = vertex;
+    }
+
+    distances[vertex] = new_distance;
+    if (is_in_queue(pq, vertex)) {
+        decrease_key(pq, vertex, new_distance);
+    } else {
+        insert(pq, vertex, new_distance);
+    }
+}
+
+static void relax_clique(CRPOverlay* overlay, int level_index,
+                         PriorityQueue* pq, int* distances, PQNode current,
+                         CRPQueryState* touched) {
+    CRPLevel* level = &overlay->partition->levels[level_index];
+    int cell = level->cell[current.vertex];
+    int index = level->boundary_index[current.vertex];
+    int begin = level->boundary_offsets[cell];
+    int count = level->boundary_offsets[cell + 1] - begin;
+
+    if (index == -1) {
+        return;
+    }
+
+    const int* row = overlay->clique_weights[level_index] +
+                     level->clique_offsets[cell] + index * count;
+
+    for (int j = 0; j < count; j++) {
+        if (row[j] != INF) {
+            relax(pq, distances, level->boundary_vertices[begin + j],
+                  current.distance + row[j], touched);
+        }
+    }
+}
+
+static void customize_cell(CRPOverlay* overlay, Graph* graph, int level_index,
+                           int cell, int* distances, PriorityQueue* pq) {
+    CRPLevel* level = &overlay->partition->levels[level_index];
+    CRPLevel* below = level_index > 0 ?
+                      &overlay->partition->levels[level_index - 1] : NULL;
+    int begin = level->boundary_offsets[cell];
+    int count = level->boundary_offsets[cell + 1] - begin;
+    int* weights = overlay->clique_weights[level_index] +
+                   level->clique_offsets[cell];
+
+    for (int i = 0; i < count; i++) {
+        for (int k = level->node_offsets[cell]; k < level->node_offsets[cell + 1]; k++) {
+            distances[level->nodes[k]] = INF;
+        }
+
+        int source = level->boundary_vertices[begin + i];
+        distances[source] = 0;
+        insert(pq, source, 0);
+
+        while (!is_empty(pq)) {
+            PQNode current = extract_min(pq);
+            int u = current.vertex;
+
+            if (below) {
+                relax_clique(overlay, level_index - 1, pq, distances, current,
+                             NULL);
+            }
+
+            for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+                int w = edge->destination;
+                if (level->cell[w] != cell ||
+                    (below && below->cell[w] == below->cell[u])) {
+                    continue;
+                }
+                relax(pq, distances, w, current.distance + edge->weight, NULL);
+            }
+        }
+
+        for (int j = 0; j < count; j++) {
+            weights[i * count + j] = distances[level->boundary_vertices[begin + j]];
+        }
+    }
+}
+
+static void* customize_worker(void* arg) {
+    CRPCustomizeContext* context = arg;
+    int n = context->graph->num_vertices;
+    CRPLevel* level = &context->overlay->partition->levels[context->level];
+
+    pthread_mutex_lock(&context->lock);
+    int worker = context->next_worker++;
+    pthread_mutex_unlock(&context->lock);
+
+    if (!pthread_equal(pthread_self(), context->owner)) {
+        pin_worker_thread(worker);
+    }
+
+    int* distances = policy_alloc(n * sizeof(int));
+    PriorityQueue* pq = create_priority_queue(n);
+
+    if (!distances || !pq) {
+        pthread_mutex_lock(&context->lock);
+        context->failed = true;
+        pthread_mutex_unlock(&context->lock);
+        policy_free(distances);
+        destroy_priority_queue(pq);
+        return NULL;
+    }
+
+    while (1) {
+        pthread_mutex_lock(&context->lock);
+        int cell = context->next_cell++;
+        pthread_mutex_unlock(&context->lock);
+
+        if (cell >= level->num_cells) {
+            break;
+        }
+
+        customize_cell(context->overlay, context->graph, context->level,
+                       cell, distances, pq);
+    }
+
+    policy_free(distances);
+    destroy_priority_queue(pq);
+    return NULL;
+}
+
+bool crp_customize(CRPOverlay* overlay, Graph* graph, int num_threads) {
+    if (!overlay || !graph ||
+        graph->num_vertices != overlay->partition->num_vertices) {
+        printf("Error: Invalid input for CRP customization\n");
+        return false;
+    }
+
+    if (num_threads < 1) {
+        num_threads = 1;
+    }
+
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    if (!threads) {
+        printf("Error: Memory allocation failed for worker threads\n");
+        return false;
+    }
+
+    CRPCustomizeContext context;
+    context.overlay = overlay;
+    context.graph = graph;
+    context.owner = pthread_self();
+    context.failed = false;
+    pthread_mutex_init(&context.lock, NULL);
+
+    /* Each level is built from the cliques of the level below, so levels
+     * are processed in order and only the cells of one level run in
+     * parallel. */
+    for (int l = 0; l < overlay->partition->num_levels && !context.failed; l++) {
+        context.level = l;
+        context.next_cell = 0;
+        context.next_worker = 0;
+
+        int started = 0;
+        for (int t = 1; t < num_threads; t++) {
+            if (pthread_create(&threads[started], NULL, customize_worker,
+                               &context) == 0) {
+                started++;
+            }
+        }
+
+        customize_worker(&context);
+
+        for (int t = 0; t < started; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+
+    pthread_mutex_destroy(&context.lock);
+    free(threads);
+
+    if (context.failed) {
+        printf("Error: Memory allocation failed during CRP customization\n");
+        overlay->customized = false;
+        return false;
+    }
+
+    overlay->customized = true;
+    overlay->customized_graph = graph;
+    overlay->customized_version = graph->version;
+    return true;
+}
+
+bool crp_overlay_is_current(const CRPOverlay* overlay, const Graph* graph) {
+    return overlay && graph && overlay->customized &&
+           overlay->customized_graph == graph &&
+           overlay->customized_version == graph->version;
+}
+
+static int query_level(CRPPartition* partition, int vertex, int source,
+                       int target) {
+    for (int l = partition->num_levels - 1; l >= 0; l--) {
+        const int* cell = partition->levels[l].cell;
+        if (cell[vertex] != cell[source] && cell[vertex] != cell[target]) {
+            return l;
+        }
+    }
+    return -1;
+}
+
+static CRPQueryState* get_query_state(CRPOverlay* overlay, int n) {
+    CRPQueryState* state = pthread_getspecific(overlay->query_key);
+    if (state) {
+        return state;
+    }
+
+    state = calloc(1, sizeof(CRPQueryState));
+    if (!state) {
+        return NULL;
+    }
+
+    state->distances = policy_alloc(n * sizeof(int));
+    state->touched = policy_alloc(n * sizeof(int));
+    state->pq = create_priority_queue(n);
+
+    if (!state->distances || !state->touched || !state->pq ||
+        pthread_setspecific(overlay->query_key, state) != 0) {
+        destroy_query_state(state);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++) {
+        state->distances[i] = INF;
+    }
+
+    pthread_mutex_lock(&overlay->query_lock);
+    state->next = overlay->query_states;
+    overlay->query_states = state;
+    pthread_mutex_unlock(&overlay->query_lock);
+
+    return state;
+}
+
+int crp_query(CRPOverlay* overlay, Graph* graph, int source, int target) {
+    if (!overlay || !overlay->customized || !is_valid_vertex(graph, source) ||
+        !is_valid_vertex(graph, target) ||
+        graph->num_vertices != overlay->partition->num_vertices) {
+        printf("Error: Invalid input for CRP query\n");
+        return INF;
+    }
+
+    if (!crp_overlay_is_current(overlay, graph)) {
+        printf("Error: CRP overlay is out of date; customize it again\n");
+        return INF;
+    }
+
+    CRPQueryState* state = get_query_state(overlay, graph->num_vertices);
+    if (!state) {
+        printf("Error: Memory allocation failed for CRP query\n");
+        return INF;
+    }
+
+    int* distances = state->distances;
+    PriorityQueue* pq = state->pq;
+
+    state->touched[state->num_touched++] = source;
+    distances[source] = 0;
+    insert(pq, source, 0);
+
+    /* Vertices outside the source and target cells are only entered
+     * through boundary vertices, so the search jumps across each such cell
+     * using the highest level clique that excludes both endpoints. */
+    while (!is_empty(pq)) {
+        PQNode current = extract_min(pq);
+        int u = current.vertex;
+
+        if (u == target) {
+            break;
+        }
+
+        int l = query_level(overlay->partition, u, source, target);
+        const int* cell = l >= 0 ? overlay->partition->levels[l].cell : NULL;
+
+        if (cell) {
+            relax_clique(overlay, l, pq, distances, current, state);
+        }
+
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            if (cell && cell[edge->destination] == cell[u]) {
+                continue;
+            }
+            relax(pq, distances, edge->destination,
+                  current.distance + edge->weight, state);
+        }
+    }
+
+    int distance = distances[target];
+
+    /* Restore only what this query touched so the next one on this thread
+     * starts from a clean state without an O(n) reset. */
+    for (int i = 0; i < state->num_touched; i++) {
+        distances[state->touched[i]] = INF;
+    }
+    state->num_touched = 0;
+    for (int i = 0; i < pq->size; i++) {
+        pq->position[pq->heap[i].vertex] = -1;
+    }
+    pq->size = 0;
+
+    return distance;
+}
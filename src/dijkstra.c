@@ -1,21 +1,74 @@
 #include "../include/dijkstra.h"
+#include "../include/dijkstra_kernel.h"
+#include "../include/allocator.h"
+
+typedef void (*DijkstraKernel)(Graph* graph, DijkstraSearch* search);
+
+#define DIJKSTRA_KERNEL_NAME(P, S, T, L) dijkstra_kernel_##P##S##T##L
+
+#define DIJKSTRA_LIST_KERNEL(P, S, T, L)                                    \
+    DIJKSTRA_KERNEL(DIJKSTRA_KERNEL_NAME(P, S, T, L), Graph,                \
+                    FOR_EACH_LIST_EDGE, P, S, T, L)
+
+#define DIJKSTRA_KERNEL_ENTRY(P, S, T, L) \
+    [P][S][T][L] = DIJKSTRA_KERNEL_NAME(P, S, T, L),
+
+#define DIJKSTRA_VARIANTS_L(X, P, S, T) X(P, S, T, 0) X(P, S, T, 1)
+#define DIJKSTRA_VARIANTS_T(X, P, S)  \
+    DIJKSTRA_VARIANTS_L(X, P, S, 0)   \
+    DIJKSTRA_VARIANTS_L(X, P, S, 1)   \
+    DIJKSTRA_VARIANTS_L(X, P, S, 2)
+#define DIJKSTRA_VARIANTS_S(X, P) \
+    DIJKSTRA_VARIANTS_T(X, P, 0)  \
+    DIJKSTRA_VARIANTS_T(X, P, 1)
+#define DIJKSTRA_VARIANTS(X) \
+    DIJKSTRA_VARIANTS_S(X, 0) \
+    DIJKSTRA_VARIANTS_S(X, 1)
+
+DIJKSTRA_VARIANTS(DIJKSTRA_LIST_KERNEL)
+
+/* Indexed by [parents][stats][DijkstraStop][lazy]. */
+static const DijkstraKernel dijkstra_kernels[2][2][3][2] = {
+    DIJKSTRA_VARIANTS(DIJKSTRA_KERNEL_ENTRY)
+};
+
+bool dijkstra_search(Graph* graph, DijkstraSearch* search) {
+    if (!graph || !search || !search->pq || !search->distances) {
+        printf("Error: Invalid input for Dijkstra search\n");
+        return false;
+    }
 
-DijkstraResult dijkstra(Graph* graph, int source) {
+    DijkstraStop stop = search->is_target ? STOP_TARGETS
+                        : search->target != -1 ? STOP_TARGET
+                                               : STOP_NONE;
+
+    dijkstra_kernels[search->parents != NULL][search->stats != NULL][stop]
+                    [search->lazy](graph, search);
+    return true;
+}
+
+DijkstraResult dijkstra_with_options(Graph* graph, int source,
+                                     const DijkstraOptions* options) {
     DijkstraResult result = {NULL, NULL, false};
 
-    if (!validate_dijkstra_input(graph, source)) {
+    if (!validate_dijkstra_input(graph, source) || !options ||
+        (options->target != -1 && !is_valid_vertex(graph, options->target))) {
         printf("Error: Invalid input for Dijkstra algorithm\n");
         return result;
     }
 
     int num_vertices = graph->num_vertices;
 
-    result.distances = malloc(num_vertices * sizeof(int));
-    result.parents = malloc(num_vertices * sizeof(int));
+    result.distances = policy_alloc(num_vertices * sizeof(int));
+    if (options->record_parents) {
+        result.parents = policy_alloc(num_vertices * sizeof(int));
+    }
 
-    if (!result.distances || !result.parents) {
+    if (!result.distances || (options->record_parents && !result.parents)) {
         printf("Error: Memory allocation failed\n");
         free_dijkstra_result(result);
+        result.distances = NULL;
+        result.parents = NULL;
         return result;
     }
 
@@ -23,12 +76,18 @@ DijkstraResult dijkstra(Graph* graph, int source) {
     if (!pq) {
         printf("Error: Failed to create priority queue\n");
         free_dijkstra_result(result);
+        result.distances = NULL;
+        result.parents = NULL;
         return result;
     }
 
     for (int i = 0; i < num_vertices; i++) {
         result.distances[i] = INF;
-        result.parents[i] = -1;
+    }
+    if (result.parents) {
+        for (int i = 0; i < num_vertices; i++) {
+            result.parents[i] = -1;
+        }
     }
 
     result.distances[source] = 0;
@@ -37,110 +96,97 @@ DijkstraResult dijkstra(Graph* graph, int source) {
         insert(pq, i, result.distances[i]);
     }
 
-    while (!is_empty(pq)) {
-        PQNode current = extract_min(pq);
-
-        if (current.vertex == -1) {
-            break;
-        }
-
-        if (current.distance == INF) {
-            break;
-        }
-
-        Edge* edge = graph->adjacency_list[current.vertex];
-        while (edge) {
-            int neighbor = edge->destination;
-            int weight = edge->weight;
-            int new_distance = result.distances[current.vertex] + weight;
-
-            if (new_distance < result.distances[neighbor] &&
-                is_in_queue(pq, neighbor)) {
-                result.distances[neighbor] = new_distance;
-                result.parents[neighbor] = current.vertex;
-                decrease_key(pq, neighbor, new_distance);
-            }
-
-            edge = edge->next;
-        }
-    }
+    DijkstraSearch search = {pq, result.distances, result.parents,
+                             options->target, NULL, 0, false, options->stats};
+    dijkstra_search(graph, &search);
 
     destroy_priority_queue(pq);
     result.success = true;
     return result;
 }
 
+DijkstraResult dijkstra(Graph* graph, int source) {
+    DijkstraOptions options = {true, -1, NULL};
+    return dijkstra_with_options(graph, source, &options);
+}
+
 DijkstraResult dijkstra_single_target(Graph* graph, int source, int target) {
-    DijkstraResult result = {NULL, NULL, false};
+    DijkstraOptions options = {true, target, NULL};
+    return dijkstra_with_options(graph, source, &options);
+}
+
+OneToManyResult dijkstra_one_to_many(Graph* graph, int source,
+                                     const int* targets, int num_targets) {
+    OneToManyResult result = {NULL, 0, false};
 
-    if (!validate_dijkstra_input(graph, source) ||
-        !is_valid_vertex(graph, target)) {
-        printf("Error: Invalid input for single target Dijkstra\n");
+    if (!validate_dijkstra_input(graph, source) || !targets ||
+        num_targets <= 0) {
+        printf("Error: Invalid input for one-to-many Dijkstra\n");
         return result;
     }
 
+    for (int i = 0; i < num_targets; i++) {
+        if (!is_valid_vertex(graph, targets[i])) {
+            printf("Error: Invalid target vertex %d\n", targets[i]);
+            return result;
+        }
+    }
+
     int num_vertices = graph->num_vertices;
 
-    result.distances = malloc(num_vertices * sizeof(int));
-    result.parents = malloc(num_vertices * sizeof(int));
+    result.distances = policy_alloc(num_targets * sizeof(int));
+    int* distances = policy_alloc(num_vertices * sizeof(int));
+    bool* is_target = policy_alloc(num_vertices * sizeof(bool));
 
-    if (!result.distances || !result.parents) {
+    if (!result.distances || !distances || !is_target) {
         printf("Error: Memory allocation failed\n");
-        free_dijkstra_result(result);
+        policy_free(distances);
+        policy_free(is_target);
+        free_one_to_many_result(result);
+        result.distances = NULL;
         return result;
     }
 
     PriorityQueue* pq = create_priority_queue(num_vertices);
     if (!pq) {
         printf("Error: Failed to create priority queue\n");
-        free_dijkstra_result(result);
+        policy_free(distances);
+        policy_free(is_target);
+        free_one_to_many_result(result);
+        result.distances = NULL;
         return result;
     }
 
     for (int i = 0; i < num_vertices; i++) {
-        result.distances[i] = INF;
-        result.parents[i] = -1;
-    }
-
-    result.distances[source] = 0;
-
-    for (int i = 0; i < num_vertices; i++) {
-        insert(pq, i, result.distances[i]);
+        distances[i] = INF;
+        is_target[i] = false;
     }
 
-    while (!is_empty(pq)) {
-        PQNode current = extract_min(pq);
-
-        if (current.vertex == -1) {
-            break;
-        }
-
-        if (current.vertex == target) {
-            break;
-        }
-
-        if (current.distance == INF) {
-            break;
+    int remaining = 0;
+    for (int i = 0; i < num_targets; i++) {
+        if (!is_target[targets[i]]) {
+            is_target[targets[i]] = true;
+            remaining++;
         }
+    }
 
-        Edge* edge = graph->adjacency_list[current.vertex];
-        while (edge) {
-            int neighbor = edge->destination;
-            int weight = edge->weight;
-            int new_distance = result.distances[current.vertex] + weight;
+    /* Vertices enter the queue only once reached, so the search never
+     * touches the part of the graph beyond the farthest target. */
+    distances[source] = 0;
+    insert(pq, source, 0);
 
-            if (new_distance < result.distances[neighbor] &&
-                is_in_queue(pq, neighbor)) {
-                result.distances[neighbor] = new_distance;
-                result.parents[neighbor] = current.vertex;
-                decrease_key(pq, neighbor, new_distance);
-            }
+    DijkstraSearch search = {pq, distances, NULL, -1, is_target, remaining,
+                             true, NULL};
+    dijkstra_search(graph, &search);
 
-            edge = edge->next;
-        }
+    for (int i = 0; i < num_targets; i++) {
+        result.distances[i] = distances[targets[i]];
     }
 
     destroy_priority_queue(pq);
+    policy_free(distances);
+    policy_free(is_target);
+    result.num_targets = num_targets;
     result.success = true;
     return result;
 }
@@ -199,10 +245,16 @@ void print_path(DijkstraResult result, int source, int destination) {
 
 void free_dijkstra_result(DijkstraResult result) {
     if (result.distances) {
-        free(result.distances);
+        policy_free(result.distances);
     }
     if (result.parents) {
-        free(result.parents);
+        policy_free(result.parents);
+    }
+}
+
+void free_one_to_many_result(OneToManyResult result) {
+    if (result.distances) {
+        policy_free(result.distances);
     }
 }
 
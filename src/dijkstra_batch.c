@@ -0,0 +1,178 @@
+#include "../include/dijkstra_batch.h"
+#include "../include/priority_queue.h"
+#include "../include/allocator.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Relaxes every lane of edge (from -> to) at once and returns a bit mask
+ * of the lanes whose distance at 'to' improved. Unreached lanes (INF) are
+ * masked so they never produce a candidate. */
+static unsigned int relax_lanes(const int* from, int* to, int weight) {
+    unsigned int improved = 0;
+
+#if defined(__SSE2__)
+    __m128i infinity = _mm_set1_epi32(INF);
+    __m128i w = _mm_set1_epi32(weight);
+
+    for (int lane = 0; lane < BATCH_LANES; lane += 4) {
+        __m128i d = _mm_loadu_si128((const __m128i*)(from + lane));
+        __m128i current = _mm_loadu_si128((const __m128i*)(to + lane));
+        __m128i unreached = _mm_cmpeq_epi32(d, infinity);
+        __m128i candidate = _mm_or_si128(
+            _mm_and_si128(unreached, infinity),
+            _mm_andnot_si128(unreached, _mm_add_epi32(d, w)));
+        __m128i smaller = _mm_cmplt_epi32(candidate, current);
+
+        _mm_storeu_si128((__m128i*)(to + lane),
+                         _mm_or_si128(_mm_and_si128(smaller, candidate),
+                                      _mm_andnot_si128(smaller, current)));
+        improved |= (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(smaller))
+                    << lane;
+    }
+#else
+    for (int lane = 0; lane < BATCH_LANES; lane++) {
+        if (from[lane] != INF && from[lane] + weight < to[lane]) {
+            to[lane] = from[lane] + weight;
+            improved |= 1u << lane;
+        }
+    }
+#endif
+
+    return improved;
+}
+
+static int min_improved_lane(const int* lanes, unsigned int improved) {
+    int best = INF;
+
+    for (int lane = 0; lane < BATCH_LANES; lane++) {
+        if ((improved & (1u << lane)) && lanes[lane] < best) {
+            best = lanes[lane];
+        }
+    }
+
+    return best;
+}
+
+/* Label-correcting search over up to BATCH_LANES sources sharing one
+ * queue. A vertex is keyed by the smallest distance that changed since
+ * it was last scanned; scanning it relaxes all lanes against a single
+ * read of its edge list. A vertex can be scanned more than once, but
+ * each rescan is driven by a real improvement in some lane. */
+static void search_lanes(Graph* graph, PriorityQueue* pq, int* lanes,
+                         const int* sources, int count) {
+    int num_vertices = graph->num_vertices;
+
+    for (int i = 0; i < num_vertices * BATCH_LANES; i++) {
+        lanes[i] = INF;
+    }
+
+    for (int lane = 0; lane < count; lane++) {
+        lanes[sources[lane] * BATCH_LANES + lane] = 0;
+        if (!is_in_queue(pq, sources[lane])) {
+            insert(pq, sources[lane], 0);
+        }
+    }
+
+    while (!is_empty(pq)) {
+        PQNode current = extract_min(pq);
+        const int* from = lanes + current.vertex * BATCH_LANES;
+
+        Edge* edge = graph->adjacency_list[current.vertex];
+        while (edge) {
+            int neighbor = edge->destination;
+            int* to = lanes + neighbor * BATCH_LANES;
+            unsigned int improved = relax_lanes(from, to, edge->weight);
+
+            if (improved) {
+                int key = min_improved_lane(to, improved);
+
+                if (!is_in_queue(pq, neighbor)) {
+                    insert(pq, neighbor, key);
+                } else if (key < pq->heap[pq->position[neighbor]].distance) {
+                    decrease_key(pq, neighbor, key);
+                }
+            }
+
+            edge = edge->next;
+        }
+    }
+}
+
+BatchResult dijkstra_batch(Graph* graph, const int* sources, int num_sources) {
+    BatchResult result = {NULL, 0, 0, false};
+
+    if (!graph || !sources || num_sources <= 0) {
+        printf("Error: Invalid input for batched Dijkstra\n");
+        return result;
+    }
+
+    for (int i = 0; i < num_sources; i++) {
+        if (!is_valid_vertex(graph, sources[i])) {
+            printf("Error: Invalid source vertex %d\n", sources[i]);
+            return result;
+        }
+    }
+
+    int num_vertices = graph->num_vertices;
+
+    result.distances = policy_alloc((size_t)num_sources * num_vertices *
+                                    sizeof(int));
+    int* lanes = policy_alloc((size_t)num_vertices * BATCH_LANES * sizeof(int));
+
+    if (!result.distances || !lanes) {
+        printf("Error: Memory allocation failed\n");
+        policy_free(result.distances);
+        policy_free(lanes);
+        result.distances = NULL;
+        return result;
+    }
+
+    PriorityQueue* pq = create_priority_queue(num_vertices);
+    if (!pq) {
+        printf("Error: Failed to create priority queue\n");
+        policy_free(result.distances);
+        policy_free(lanes);
+        result.distances = NULL;
+        return result;
+    }
+
+    for (int first = 0; first < num_sources; first += BATCH_LANES) {
+        int count = num_sources - first;
+        if (count > BATCH_LANES) {
+            count = BATCH_LANES;
+        }
+
+        search_lanes(graph, pq, lanes, sources + first, count);
+
+        for (int lane = 0; lane < count; lane++) {
+            int* row = result.distances + (size_t)(first + lane) * num_vertices;
+            for (int v = 0; v < num_vertices; v++) {
+                row[v] = lanes[v * BATCH_LANES + lane];
+            }
+        }
+    }
+
+    destroy_priority_queue(pq);
+    policy_free(lanes);
+    result.num_sources = num_sources;
+    result.num_vertices = num_vertices;
+    result.success = true;
+    return result;
+}
+
+int batch_distance(BatchResult result, int source_index, int vertex) {
+    if (!result.success || source_index < 0 ||
+        source_index >= result.num_sources || vertex < 0 ||
+        vertex >= result.num_vertices) {
+        return INF;
+    }
+
+    return result.distances[(size_t)source_index * result.num_vertices + vertex];
+}
+
+void free_batch_result(BatchResult result) {
+    if (result.distances) {
+        policy_free(result.distances);
+    }
+}
@@ -0,0 +1,171 @@
+#include "../include/dijkstra_interleaved.h"
+#include "../include/allocator.h"
+#include "../include/dijkstra_kernel.h"
+
+#if defined(__GNUC__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)(address))
+#endif
+
+/* Each slot runs one query as a state machine that stops after issuing a
+ * prefetch, so the next slot's work overlaps the miss. Every query still
+ * performs exactly the queue operations of dijkstra() in the same order,
+ * which keeps distances and parents (including ties) identical. */
+
+static void reset_queue(PriorityQueue* pq) {
+    for (int i = 0; i < pq->size; i++) {
+        pq->position[pq->heap[i].vertex] = -1;
+    }
+    pq->size = 0;
+}
+
+static bool start_query(Graph* graph, QuerySlot* slot, int source,
+                        DijkstraResult* result) {
+    int num_vertices = graph->num_vertices;
+
+    result->distances = policy_alloc(num_vertices * sizeof(int));
+    result->parents = policy_alloc(num_vertices * sizeof(int));
+    result->success = false;
+
+    if (!result->distances || !result->parents) {
+        printf("Error: Memory allocation failed\n");
+        return false;
+    }
+
+    for (int i = 0; i < num_vertices; i++) {
+        result->distances[i] = INF;
+        result->parents[i] = -1;
+    }
+
+    result->distances[source] = 0;
+
+    reset_queue(slot->pq);
+    for (int i = 0; i < num_vertices; i++) {
+        insert(slot->pq, i, result->distances[i]);
+    }
+
+    slot->stage = STAGE_EXTRACT;
+    return true;
+}
+
+/* Advances a slot by one stage; returns false once its query is done.
+ * A stage touches at most one edge and prefetches the next one, which is
+ * read only on the slot's next turn, after the other slots have run. */
+static bool step_query(Graph* graph, QuerySlot* slot, DijkstraResult* result) {
+    if (slot->stage == STAGE_EXTRACT) {
+        if (is_empty(slot->pq)) {
+            return false;
+        }
+
+        PQNode current = extract_min(slot->pq);
+        if (current.vertex == -1 || current.distance == INF) {
+            return false;
+        }
+
+        slot->vertex = current.vertex;
+        slot->edge = graph->adjacency_list[current.vertex];
+        PREFETCH(slot->edge);
+        slot->stage = STAGE_RELAX;
+        return true;
+    }
+
+    Edge* edge = slot->edge;
+    if (!edge) {
+        slot->stage = STAGE_EXTRACT;
+        return true;
+    }
+
+    int neighbor = edge->destination;
+    int new_distance = result->distances[slot->vertex] + edge->weight;
+
+    DIJKSTRA_RELAX(slot->pq, result->distances, result->parents, neighbor,
+                   new_distance, slot->vertex, 1, 0, (void)0);
+
+    slot->edge = edge->next;
+    PREFETCH(slot->edge);
+    return true;
+}
+
+bool dijkstra_interleaved(Graph* graph, const int* sources, int num_sources,
+                          int width, DijkstraResult* results) {
+    if (!graph || !sources || !results || num_sources <= 0) {
+        printf("Error: Invalid input for interleaved Dijkstra\n");
+        return false;
+    }
+
+    for (int i = 0; i < num_sources; i++) {
+        results[i].distances = NULL;
+        results[i].parents = NULL;
+        results[i].success = false;
+
+        if (!is_valid_vertex(graph, sources[i])) {
+            printf("Error: Invalid source vertex %d\n", sources[i]);
+            return false;
+        }
+    }
+
+    if (width <= 0) {
+        width = INTERLEAVE_WIDTH;
+    }
+    if (width > num_sources) {
+        width = num_sources;
+    }
+
+    QuerySlot* slots = calloc(width, sizeof(QuerySlot));
+    if (!slots) {
+        printf("Error: Memory allocation failed for query slots\n");
+        return false;
+    }
+
+    bool ok = true;
+    for (int s = 0; s < width && ok; s++) {
+        slots[s].query = -1;
+        slots[s].stage = STAGE_START;
+        slots[s].pq = create_priority_queue(graph->num_vertices);
+        ok = slots[s].pq != NULL;
+    }
+
+    int next_query = 0;
+    int completed = 0;
+
+    while (ok && completed < num_sources) {
+        for (int s = 0; s < width && ok; s++) {
+            QuerySlot* slot = &slots[s];
+
+            if (slot->stage == STAGE_START) {
+                if (next_query == num_sources) {
+                    continue;
+                }
+
+                slot->query = next_query++;
+                ok = start_query(graph, slot, sources[slot->query],
+                                 &results[slot->query]);
+                continue;
+            }
+
+            if (!step_query(graph, slot, &results[slot->query])) {
+                results[slot->query].success = true;
+                slot->stage = STAGE_START;
+                completed++;
+            }
+        }
+    }
+
+    for (int s = 0; s < width; s++) {
+        destroy_priority_queue(slots[s].pq);
+    }
+    free(slots);
+
+    if (!ok) {
+        for (int i = 0; i < num_sources; i++) {
+            free_dijkstra_result(results[i]);
+            results[i].distances = NULL;
+            results[i].parents = NULL;
+            results[i].success = false;
+        }
+        return false;
+    }
+
+    return true;
+}
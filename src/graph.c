@@ -1,4 +1,8 @@
 #include "../include/graph.h"
+#include "../include/allocator.h"
+
+#define EDGE_CHUNK_MIN 256
+#define EDGE_CHUNK_MAX (1 << 17)
 
 Graph* create_graph(int num_vertices) {
     if (num_vertices <= 0 || num_vertices > MAX_VERTICES) {
@@ -13,18 +17,20 @@ Graph* create_graph(int num_vertices) {
     }
 
     graph->num_vertices = num_vertices;
+    graph->edge_chunks = NULL;
+    graph->version = 0;
 
-    graph->adjacency_list = malloc(num_vertices * sizeof(Edge*));
+    graph->adjacency_list = policy_alloc(num_vertices * sizeof(Edge*));
     if (!graph->adjacency_list) {
         printf("Error: Memory allocation failed for adjacency list\n");
         free(graph);
         return NULL;
     }
 
-    graph->vertex_degrees = malloc(num_vertices * sizeof(int));
+    graph->vertex_degrees = policy_alloc(num_vertices * sizeof(int));
     if (!graph->vertex_degrees) {
         printf("Error: Memory allocation failed for vertex degrees\n");
-        free(graph->adjacency_list);
+        policy_free(graph->adjacency_list);
         free(graph);
         return NULL;
     }
@@ -37,21 +43,97 @@ Graph* create_graph(int num_vertices) {
     return graph;
 }
 
+/* Edges are carved from chunks obtained through the allocation policy, so
+ * the bulk of a graph's memory gets the same page size and NUMA placement
+ * as its arrays. Chunks double up to EDGE_CHUNK_MAX edges. */
+static EdgeChunk* push_edge_chunk(Graph* graph, int capacity) {
+    EdgeChunk* chunk = policy_alloc(sizeof(EdgeChunk) + capacity * sizeof(Edge));
+    if (!chunk) {
+        return NULL;
+    }
+
+    chunk->next = graph->edge_chunks;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    graph->edge_chunks = chunk;
+    return chunk;
+}
+
+static Edge* allocate_edge(Graph* graph) {
+    EdgeChunk* chunk = graph->edge_chunks;
+
+    if (!chunk || chunk->used == chunk->capacity) {
+        int capacity = chunk ? chunk->capacity * 2 : EDGE_CHUNK_MIN;
+        if (capacity > EDGE_CHUNK_MAX) {
+            capacity = EDGE_CHUNK_MAX;
+        }
+
+        chunk = push_edge_chunk(graph, capacity);
+        if (!chunk) {
+            return NULL;
+        }
+    }
+
+    return &chunk->edges[chunk->used++];
+}
+
 void destroy_graph(Graph* graph) {
     if (!graph) return;
 
+    while (graph->edge_chunks) {
+        EdgeChunk* next = graph->edge_chunks->next;
+        policy_free(graph->edge_chunks);
+        graph->edge_chunks = next;
+    }
+
+    policy_free(graph->adjacency_list);
+    policy_free(graph->vertex_degrees);
+    free(graph);
+}
+
+Graph* copy_graph(Graph* graph) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    Graph* copy = create_graph(graph->num_vertices);
+    if (!copy) {
+        return NULL;
+    }
+
+    int num_edges = 0;
     for (int i = 0; i < graph->num_vertices; i++) {
-        Edge* current = graph->adjacency_list[i];
-        while (current) {
-            Edge* temp = current;
-            current = current->next;
-            free(temp);
+        num_edges += graph->vertex_degrees[i];
+    }
+
+    /* One chunk for the whole copy keeps each vertex's edges consecutive. */
+    if (num_edges > 0 && !push_edge_chunk(copy, num_edges)) {
+        printf("Error: Memory allocation failed for edge\n");
+        destroy_graph(copy);
+        return NULL;
+    }
+
+    for (int i = 0; i < graph->num_vertices; i++) {
+        Edge** tail = &copy->adjacency_list[i];
+        for (Edge* edge = graph->adjacency_list[i]; edge; edge = edge->next) {
+            Edge* new_edge = allocate_edge(copy);
+            if (!new_edge) {
+                printf("Error: Memory allocation failed for edge\n");
+                destroy_graph(copy);
+                return NULL;
+            }
+
+            new_edge->destination = edge->destination;
+            new_edge->weight = edge->weight;
+            new_edge->next = NULL;
+            *tail = new_edge;
+            tail = &new_edge->next;
+            copy->vertex_degrees[i]++;
         }
     }
 
-    free(graph->adjacency_list);
-    free(graph->vertex_degrees);
-    free(graph);
+    return copy;
 }
 
 void add_edge(Graph* graph, int source, int destination, int weight) {
@@ -70,7 +152,7 @@ void add_edge(Graph* graph, int source, int destination, int weight) {
         return;
     }
 
-    Edge* new_edge = malloc(sizeof(Edge));
+    Edge* new_edge = allocate_edge(graph);
     if (!new_edge) {
         printf("Error: Memory allocation failed for edge\n");
         return;
@@ -81,6 +163,37 @@ void add_edge(Graph* graph, int source, int destination, int weight) {
     new_edge->next = graph->adjacency_list[source];
     graph->adjacency_list[source] = new_edge;
     graph->vertex_degrees[source]++;
+    graph->version++;
+}
+
+bool set_edge_weight(Graph* graph, int source, int destination, int weight) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return false;
+    }
+
+    if (!is_valid_vertex(graph, source) || !is_valid_vertex(graph, destination)) {
+        printf("Error: Invalid vertex indices\n");
+        return false;
+    }
+
+    if (weight < 0) {
+        printf("Error: Negative weight not allowed\n");
+        return false;
+    }
+
+    bool found = false;
+    for (Edge* edge = graph->adjacency_list[source]; edge; edge = edge->next) {
+        if (edge->destination == destination) {
+            edge->weight = weight;
+            found = true;
+        }
+    }
+
+    if (found) {
+        graph->version++;
+    }
+    return found;
 }
 
 void print_graph(Graph* graph) {
@@ -108,4 +221,17 @@ void print_graph(Graph* graph) {
 
 bool is_valid_vertex(Graph* graph, int vertex) {
     return graph && vertex >= 0 && vertex < graph->num_vertices;
+}
+
+size_t graph_memory_usage(Graph* graph) {
+    if (!graph) return 0;
+
+    size_t edges = 0;
+    for (int i = 0; i < graph->num_vertices; i++) {
+        edges += graph->vertex_degrees[i];
+    }
+
+    return sizeof(Graph) +
+           graph->num_vertices * (sizeof(Edge*) + sizeof(int)) +
+           edges * sizeof(Edge);
 }
\ No newline at end of file
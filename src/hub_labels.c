@@ -0,0 +1,823 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/hub_labels.h"
+#include "../include/priority_queue.h"
+#include <string.h>
+#include <time.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define HUB_LABELS_MAGIC 0x4C425548
+#define HUB_LABELS_VERSION 2
+#define HUB_LABELS_SAMPLE_QUERIES 100000
+#define VARINT_MAX_BYTES 5
+
+typedef struct LabelBuilder {
+    int* hubs;
+    int* distances;
+    int size;
+    int capacity;
+} LabelBuilder;
+
+typedef struct SearchState {
+    PriorityQueue* pq;
+    int* distances;
+    int* touched;
+    int* root_distances;
+} SearchState;
+
+typedef struct VertexDegree {
+    int vertex;
+    int degree;
+} VertexDegree;
+
+static double elapsed_ms(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * 1000.0 +
+           (end.tv_nsec - start.tv_nsec) / 1000000.0;
+}
+
+static bool append_label(LabelBuilder* label, int hub, int distance) {
+    if (label->size == label->capacity) {
+        int capacity = label->capacity ? label->capacity * 2 : 4;
+        int* hubs = realloc(label->hubs, capacity * sizeof(int));
+        if (!hubs) {
+            return false;
+        }
+        label->hubs = hubs;
+
+        int* distances = realloc(label->distances, capacity * sizeof(int));
+        if (!distances) {
+            return false;
+        }
+        label->distances = distances;
+        label->capacity = capacity;
+    }
+
+    label->hubs[label->size] = hub;
+    label->distances[label->size] = distance;
+    label->size++;
+    return true;
+}
+
+static int compare_degree(const void* a, const void* b) {
+    const VertexDegree* x = a;
+    const VertexDegree* y = b;
+
+    if (x->degree != y->degree) {
+        return y->degree - x->degree;
+    }
+    return x->vertex - y->vertex;
+}
+
+static bool compute_degree_order(Graph* graph, int* order) {
+    int n = graph->num_vertices;
+    VertexDegree* degrees = malloc(n * sizeof(VertexDegree));
+    if (!degrees) {
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        degrees[v].vertex = v;
+        degrees[v].degree = graph->vertex_degrees[v];
+    }
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            degrees[edge->destination].degree++;
+        }
+    }
+
+    qsort(degrees, n, sizeof(VertexDegree), compare_degree);
+
+    for (int r = 0; r < n; r++) {
+        order[r] = degrees[r].vertex;
+    }
+
+    free(degrees);
+    return true;
+}
+
+static bool validate_order(const int* order, int n) {
+    bool* seen = calloc(n, sizeof(bool));
+    bool valid = seen != NULL;
+
+    for (int r = 0; valid && r < n; r++) {
+        if (order[r] < 0 || order[r] >= n || seen[order[r]]) {
+            valid = false;
+        } else {
+            seen[order[r]] = true;
+        }
+    }
+
+    free(seen);
+    return valid;
+}
+
+/* Pruned Dijkstra from the hub of the given rank. A vertex whose distance
+ * is already covered by the labels of higher-ranked hubs is neither
+ * labelled nor expanded. */
+static bool pruned_search(Graph* graph, int root, int rank,
+                          const LabelBuilder* root_label,
+                          LabelBuilder* labels, SearchState* state) {
+    int num_touched = 0;
+    bool ok = true;
+
+    for (int i = 0; i < root_label->size; i++) {
+        state->root_distances[root_label->hubs[i]] = root_label->distances[i];
+    }
+
+    state->distances[root] = 0;
+    state->touched[num_touched++] = root;
+    insert(state->pq, root, 0);
+
+    while (!is_empty(state->pq)) {
+        PQNode current = extract_min(state->pq);
+        int u = current.vertex;
+        LabelBuilder* label = &labels[u];
+
+        bool covered = false;
+        for (int i = 0; i < label->size; i++) {
+            int hub_distance = state->root_distances[label->hubs[i]];
+            if (hub_distance != INF &&
+                hub_distance + label->distances[i] <= current.distance) {
+                covered = true;
+                break;
+            }
+        }
+
+        if (covered) {
+            continue;
+        }
+
+        if (!append_label(label, rank, current.distance)) {
+            ok = false;
+            break;
+        }
+
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            int w = edge->destination;
+            int new_distance = current.distance + edge->weight;
+
+            if (new_distance >= state->distances[w]) {
+                continue;
+            }
+
+            if (state->distances[w] == INF) {
+                state->touched[num_touched++] = w;
+            }
+            state->distances[w] = new_distance;
+
+            if (is_in_queue(state->pq, w)) {
+                decrease_key(state->pq, w, new_distance);
+            } else {
+                insert(state->pq, w, new_distance);
+            }
+        }
+    }
+
+    while (!is_empty(state->pq)) {
+        extract_min(state->pq);
+    }
+    for (int i = 0; i < num_touched; i++) {
+        state->distances[state->touched[i]] = INF;
+    }
+    for (int i = 0; i < root_label->size; i++) {
+        state->root_distances[root_label->hubs[i]] = INF;
+    }
+
+    return ok;
+}
+
+static bool pack_labels(LabelSet* set, const LabelBuilder* labels, int n) {
+    set->offsets = malloc((n + 1) * sizeof(int));
+    if (!set->offsets) {
+        return false;
+    }
+
+    set->offsets[0] = 0;
+    for (int v = 0; v < n; v++) {
+        set->offsets[v + 1] = set->offsets[v] + labels[v].size;
+    }
+
+    int total = set->offsets[n];
+    set->hubs = malloc((total + 1) * sizeof(int));
+    set->distances = malloc((total + 1) * sizeof(int));
+    if (!set->hubs || !set->distances) {
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        memcpy(set->hubs + set->offsets[v], labels[v].hubs,
+               labels[v].size * sizeof(int));
+        memcpy(set->distances + set->offsets[v], labels[v].distances,
+               labels[v].size * sizeof(int));
+    }
+
+    return true;
+}
+
+static void free_builders(LabelBuilder* labels, int n) {
+    if (!labels) return;
+
+    for (int v = 0; v < n; v++) {
+        free(labels[v].hubs);
+        free(labels[v].distances);
+    }
+    free(labels);
+}
+
+static Graph* create_reverse_graph(Graph* graph) {
+    Graph* reverse = create_graph(graph->num_vertices);
+    if (!reverse) {
+        return NULL;
+    }
+
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            add_edge(reverse, edge->destination, u, edge->weight);
+        }
+    }
+
+    return reverse;
+}
+
+static void measure_queries(const HubLabels* labels, HubLabelStats* stats) {
+    struct timespec start, end;
+    unsigned int state = 12345;
+    volatile int sink = 0;
+    int n = labels->num_vertices;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < HUB_LABELS_SAMPLE_QUERIES; i++) {
+        state = state * 1103515245u + 12345u;
+        int source = (state >> 8) % n;
+        state = state * 1103515245u + 12345u;
+        int target = (state >> 8) % n;
+        sink += hub_label_query(labels, source, target);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    (void)sink;
+    stats->query_time_ns = elapsed_ms(start, end) * 1000000.0 /
+                           HUB_LABELS_SAMPLE_QUERIES;
+}
+
+HubLabels* build_hub_labels(Graph* graph, const int* order, HubLabelStats* stats) {
+    if (!graph) {
+        printf("Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    int n = graph->num_vertices;
+
+    if (order && !validate_order(order, n)) {
+        printf("Error: Vertex order must be a permutation of all vertices\n");
+        return NULL;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    HubLabels* labels = calloc(1, sizeof(HubLabels));
+    LabelBuilder* out_builders = calloc(n, sizeof(LabelBuilder));
+    LabelBuilder* in_builders = calloc(n, sizeof(LabelBuilder));
+    Graph* reverse = create_reverse_graph(graph);
+
+    SearchState state;
+    state.pq = create_priority_queue(n);
+    state.distances = malloc(n * sizeof(int));
+    state.touched = malloc(n * sizeof(int));
+    state.root_distances = malloc(n * sizeof(int));
+
+    bool ok = labels && out_builders && in_builders && reverse && state.pq &&
+              state.distances && state.touched && state.root_distances;
+
+    if (ok) {
+        labels->num_vertices = n;
+        labels->order = malloc(n * sizeof(int));
+        ok = labels->order != NULL;
+    }
+
+    if (ok) {
+        if (order) {
+            memcpy(labels->order, order, n * sizeof(int));
+        } else {
+            ok = compute_degree_order(graph, labels->order);
+        }
+    }
+
+    if (ok) {
+        for (int v = 0; v < n; v++) {
+            state.distances[v] = INF;
+            state.root_distances[v] = INF;
+        }
+    }
+
+    /* Hubs are processed in rank order, so every label comes out sorted by
+     * hub rank and queries can merge-join without sorting. */
+    for (int rank = 0; ok && rank < n; rank++) {
+        int root = labels->order[rank];
+        ok = pruned_search(graph, root, rank, &out_builders[root],
+                           in_builders, &state) &&
+             pruned_search(reverse, root, rank, &in_builders[root],
+                           out_builders, &state);
+    }
+
+    if (ok) {
+        ok = pack_labels(&labels->out_labels, out_builders, n) &&
+             pack_labels(&labels->in_labels, in_builders, n);
+    }
+
+    free_builders(out_builders, n);
+    free_builders(in_builders, n);
+    destroy_graph(reverse);
+    destroy_priority_queue(state.pq);
+    free(state.distances);
+    free(state.touched);
+    free(state.root_distances);
+
+    if (!ok) {
+        printf("Error: Memory allocation failed while building hub labels\n");
+        destroy_hub_labels(labels);
+        return NULL;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (stats) {
+        int entries = labels->out_labels.offsets[n] + labels->in_labels.offsets[n];
+        stats->build_time_ms = elapsed_ms(start, end);
+        stats->average_label_size = (double)entries / n;
+        stats->bytes_per_vertex = (double)hub_labels_memory_usage(labels) / n;
+        measure_queries(labels, stats);
+    }
+
+    return labels;
+}
+
+void destroy_hub_labels(HubLabels* labels) {
+    if (!labels) return;
+
+    free(labels->order);
+    free(labels->out_labels.offsets);
+    free(labels->out_labels.hubs);
+    free(labels->out_labels.distances);
+    free(labels->in_labels.offsets);
+    free(labels->in_labels.hubs);
+    free(labels->in_labels.distances);
+    free(labels->out_labels.byte_offsets);
+    free(labels->out_labels.packed);
+    free(labels->in_labels.byte_offsets);
+    free(labels->in_labels.packed);
+    free(labels);
+}
+
+/* The compressed form stores each label as (hub delta, distance) pairs in
+ * LEB128 varints: hubs are sorted by rank, so the deltas are small, and
+ * most distances fit in one or two bytes. */
+static uint8_t* put_varint(uint8_t* out, uint32_t value) {
+    while (value >= 0x80) {
+        *out++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+    return out;
+}
+
+static const uint8_t* get_varint(const uint8_t* in, const uint8_t* end,
+                                 uint32_t* value) {
+    uint32_t result = 0;
+
+    for (int shift = 0; shift < 7 * VARINT_MAX_BYTES && in < end; shift += 7) {
+        uint8_t byte = *in++;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return in;
+        }
+    }
+
+    return NULL;
+}
+
+/* Decodes one label, rejecting anything that is not strictly increasing
+ * in hub rank or does not fit in the given bytes. */
+static bool decode_label(const uint8_t* in, const uint8_t* end, int size,
+                         int num_vertices, int* hubs, int* distances) {
+    uint32_t hub = 0;
+
+    for (int k = 0; k < size; k++) {
+        uint32_t delta, distance;
+
+        in = get_varint(in, end, &delta);
+        if (!in || !(in = get_varint(in, end, &distance))) {
+            return false;
+        }
+        if ((k > 0 && delta == 0) || delta >= (uint32_t)num_vertices - hub ||
+            distance >= INF) {
+            return false;
+        }
+
+        hub += delta;
+        hubs[k] = (int)hub;
+        distances[k] = (int)distance;
+    }
+
+    return in == end;
+}
+
+static int intersect_labels(const int* a_hubs, const int* a_distances, int a_size,
+                            const int* b_hubs, const int* b_distances, int b_size) {
+    int best = INF;
+    int i = 0, j = 0;
+
+#if defined(__SSE2__)
+    /* Compare 4x4 blocks of hub ids by rotating one block against the
+     * other, keeping a running per-lane minimum of the matched sums. */
+    __m128i best_lanes = _mm_set1_epi32(INF);
+    __m128i infinity = _mm_set1_epi32(INF);
+
+    while (i + 4 <= a_size && j + 4 <= b_size) {
+        __m128i a_hub = _mm_loadu_si128((const __m128i*)(a_hubs + i));
+        __m128i a_dist = _mm_loadu_si128((const __m128i*)(a_distances + i));
+        __m128i b_hub = _mm_loadu_si128((const __m128i*)(b_hubs + j));
+        __m128i b_dist = _mm_loadu_si128((const __m128i*)(b_distances + j));
+
+        for (int r = 0; r < 4; r++) {
+            __m128i match = _mm_cmpeq_epi32(a_hub, b_hub);
+            __m128i sum = _mm_add_epi32(a_dist, b_dist);
+            __m128i candidate = _mm_or_si128(_mm_and_si128(match, sum),
+                                             _mm_andnot_si128(match, infinity));
+            __m128i smaller = _mm_cmplt_epi32(candidate, best_lanes);
+            best_lanes = _mm_or_si128(_mm_and_si128(smaller, candidate),
+                                      _mm_andnot_si128(smaller, best_lanes));
+
+            b_hub = _mm_shuffle_epi32(b_hub, _MM_SHUFFLE(0, 3, 2, 1));
+            b_dist = _mm_shuffle_epi32(b_dist, _MM_SHUFFLE(0, 3, 2, 1));
+        }
+
+        int a_last = a_hubs[i + 3];
+        int b_last = b_hubs[j + 3];
+        if (a_last <= b_last) {
+            i += 4;
+        }
+        if (b_last <= a_last) {
+            j += 4;
+        }
+    }
+
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, best_lanes);
+    for (int k = 0; k < 4; k++) {
+        if (lanes[k] < best) {
+            best = lanes[k];
+        }
+    }
+#endif
+
+    while (i < a_size && j < b_size) {
+        if (a_hubs[i] < b_hubs[j]) {
+            i++;
+        } else if (a_hubs[i] > b_hubs[j]) {
+            j++;
+        } else {
+            int sum = a_distances[i] + b_distances[j];
+            if (sum < best) {
+                best = sum;
+            }
+            i++;
+            j++;
+        }
+    }
+
+    return best < INF ? best : INF;
+}
+
+/* Decoded labels for the intersect path, aligned for the SSE2 loads. */
+typedef union LabelBlock {
+#if defined(__SSE2__)
+    __m128i lanes[(MAX_VERTICES + 3) / 4];
+#endif
+    int values[(MAX_VERTICES + 3) / 4 * 4];
+} LabelBlock;
+
+static int compressed_query(const HubLabels* labels, int source, int target) {
+    const LabelSet* out = &labels->out_labels;
+    const LabelSet* in = &labels->in_labels;
+    int out_size = out->offsets[source + 1] - out->offsets[source];
+    int in_size = in->offsets[target + 1] - in->offsets[target];
+    LabelBlock out_hubs, out_distances, in_hubs, in_distances;
+
+    if (!decode_label(out->packed + out->byte_offsets[source],
+                      out->packed + out->byte_offsets[source + 1], out_size,
+                      labels->num_vertices, out_hubs.values,
+                      out_distances.values) ||
+        !decode_label(in->packed + in->byte_offsets[target],
+                      in->packed + in->byte_offsets[target + 1], in_size,
+                      labels->num_vertices, in_hubs.values,
+                      in_distances.values)) {
+        printf("Error: Corrupt compressed hub label\n");
+        return INF;
+    }
+
+    return intersect_labels(out_hubs.values, out_distances.values, out_size,
+                            in_hubs.values, in_distances.values, in_size);
+}
+
+int hub_label_query(const HubLabels* labels, int source, int target) {
+    if (!labels || source < 0 || target < 0 ||
+        source >= labels->num_vertices || target >= labels->num_vertices) {
+        printf("Error: Invalid input for hub label query\n");
+        return INF;
+    }
+
+    if (labels->compressed) {
+        return compressed_query(labels, source, target);
+    }
+
+    const LabelSet* out = &labels->out_labels;
+    const LabelSet* in = &labels->in_labels;
+    int out_begin = out->offsets[source];
+    int in_begin = in->offsets[target];
+
+    return intersect_labels(out->hubs + out_begin, out->distances + out_begin,
+                            out->offsets[source + 1] - out_begin,
+                            in->hubs + in_begin, in->distances + in_begin,
+                            in->offsets[target + 1] - in_begin);
+}
+
+size_t hub_labels_memory_usage(const HubLabels* labels) {
+    if (!labels) return 0;
+
+    size_t n = labels->num_vertices;
+    size_t base = sizeof(HubLabels) + n * sizeof(int) + 2 * (n + 1) * sizeof(int);
+
+    if (labels->compressed) {
+        return base + 2 * (n + 1) * sizeof(uint32_t) +
+               labels->out_labels.byte_offsets[n] +
+               labels->in_labels.byte_offsets[n];
+    }
+
+    size_t entries = labels->out_labels.offsets[n] + labels->in_labels.offsets[n];
+    return base + entries * 2 * sizeof(int);
+}
+
+static bool encode_label_set(LabelSet* set, int n) {
+    int total = set->offsets[n];
+
+    set->byte_offsets = malloc((n + 1) * sizeof(uint32_t));
+    set->packed = malloc((size_t)total * 2 * VARINT_MAX_BYTES + 1);
+    if (!set->byte_offsets || !set->packed) {
+        return false;
+    }
+
+    uint8_t* out = set->packed;
+    set->byte_offsets[0] = 0;
+
+    for (int v = 0; v < n; v++) {
+        int previous = 0;
+        for (int k = set->offsets[v]; k < set->offsets[v + 1]; k++) {
+            out = put_varint(out, (uint32_t)(set->hubs[k] - previous));
+            out = put_varint(out, (uint32_t)set->distances[k]);
+            previous = set->hubs[k];
+        }
+        set->byte_offsets[v + 1] = (uint32_t)(out - set->packed);
+    }
+
+    uint8_t* packed = realloc(set->packed, set->byte_offsets[n] + 1);
+    if (packed) {
+        set->packed = packed;
+    }
+    return true;
+}
+
+static bool decode_label_set(LabelSet* set, int n) {
+    int total = set->offsets[n];
+
+    set->hubs = malloc((total + 1) * sizeof(int));
+    set->distances = malloc((total + 1) * sizeof(int));
+    if (!set->hubs || !set->distances) {
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        int begin = set->offsets[v];
+        if (!decode_label(set->packed + set->byte_offsets[v],
+                          set->packed + set->byte_offsets[v + 1],
+                          set->offsets[v + 1] - begin, n,
+                          set->hubs + begin, set->distances + begin)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void release_plain(LabelSet* set) {
+    free(set->hubs);
+    free(set->distances);
+    set->hubs = NULL;
+    set->distances = NULL;
+}
+
+static void release_packed(LabelSet* set) {
+    free(set->byte_offsets);
+    free(set->packed);
+    set->byte_offsets = NULL;
+    set->packed = NULL;
+}
+
+/* Switches the labels to cold storage; queries then decode the two labels
+ * they touch instead of reading the plain arrays. */
+bool compress_hub_labels(HubLabels* labels) {
+    if (!labels) {
+        printf("Error: Hub labels are NULL\n");
+        return false;
+    }
+
+    if (labels->compressed) {
+        return true;
+    }
+
+    int n = labels->num_vertices;
+    if (!encode_label_set(&labels->out_labels, n) ||
+        !encode_label_set(&labels->in_labels, n)) {
+        printf("Error: Memory allocation failed while compressing hub labels\n");
+        release_packed(&labels->out_labels);
+        release_packed(&labels->in_labels);
+        return false;
+    }
+
+    release_plain(&labels->out_labels);
+    release_plain(&labels->in_labels);
+    labels->compressed = true;
+    return true;
+}
+
+bool expand_hub_labels(HubLabels* labels) {
+    if (!labels) {
+        printf("Error: Hub labels are NULL\n");
+        return false;
+    }
+
+    if (!labels->compressed) {
+        return true;
+    }
+
+    int n = labels->num_vertices;
+    if (!decode_label_set(&labels->out_labels, n) ||
+        !decode_label_set(&labels->in_labels, n)) {
+        printf("Error: Failed to expand hub labels\n");
+        release_plain(&labels->out_labels);
+        release_plain(&labels->in_labels);
+        return false;
+    }
+
+    release_packed(&labels->out_labels);
+    release_packed(&labels->in_labels);
+    labels->compressed = false;
+    return true;
+}
+
+static bool write_ints(FILE* file, const int* values, size_t count) {
+    return fwrite(values, sizeof(int), count, file) == count;
+}
+
+static bool read_ints(FILE* file, int* values, size_t count) {
+    return fread(values, sizeof(int), count, file) == count;
+}
+
+static bool write_label_set(FILE* file, const LabelSet* set, int n) {
+    return write_ints(file, set->offsets, n + 1) &&
+           fwrite(set->byte_offsets, sizeof(uint32_t), n + 1, file) ==
+               (size_t)(n + 1) &&
+           fwrite(set->packed, 1, set->byte_offsets[n], file) ==
+               set->byte_offsets[n];
+}
+
+/* Files hold the compressed form; loading decodes it back to the plain
+ * arrays, validating every label on the way. */
+static bool read_label_set(FILE* file, LabelSet* set, int n) {
+    set->offsets = malloc((n + 1) * sizeof(int));
+    if (!set->offsets || !read_ints(file, set->offsets, n + 1) ||
+        set->offsets[0] != 0 || set->offsets[n] < 0) {
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        if (set->offsets[v + 1] < set->offsets[v] ||
+            set->offsets[v + 1] - set->offsets[v] > n) {
+            return false;
+        }
+    }
+
+    set->byte_offsets = malloc((n + 1) * sizeof(uint32_t));
+    if (!set->byte_offsets ||
+        fread(set->byte_offsets, sizeof(uint32_t), n + 1, file) !=
+            (size_t)(n + 1) ||
+        set->byte_offsets[0] != 0) {
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        if (set->byte_offsets[v + 1] < set->byte_offsets[v]) {
+            return false;
+        }
+    }
+
+    set->packed = malloc(set->byte_offsets[n] + 1);
+    if (!set->packed ||
+        fread(set->packed, 1, set->byte_offsets[n], file) != set->byte_offsets[n] ||
+        !decode_label_set(set, n)) {
+        return false;
+    }
+
+    release_packed(set);
+    return true;
+}
+
+bool save_hub_labels(const HubLabels* labels, const char* filename) {
+    if (!labels || !filename) {
+        printf("Error: Invalid input for saving hub labels\n");
+        return false;
+    }
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error: Cannot open %s for writing\n", filename);
+        return false;
+    }
+
+    int n = labels->num_vertices;
+    int header[3] = {HUB_LABELS_MAGIC, HUB_LABELS_VERSION, n};
+
+    /* Plain labels are encoded into a temporary copy of the sets, so the
+     * caller's labels keep their form. */
+    LabelSet out = labels->out_labels;
+    LabelSet in = labels->in_labels;
+    bool encoded = !labels->compressed;
+
+    bool ok = !encoded || (encode_label_set(&out, n) && encode_label_set(&in, n));
+    ok = ok && write_ints(file, header, 3) &&
+         write_ints(file, labels->order, n) &&
+         write_label_set(file, &out, n) &&
+         write_label_set(file, &in, n);
+
+    if (encoded) {
+        release_packed(&out);
+        release_packed(&in);
+    }
+
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+
+    if (!ok) {
+        printf("Error: Failed to write hub labels to %s\n", filename);
+    }
+    return ok;
+}
+
+HubLabels* load_hub_labels(const char* filename) {
+    if (!filename) {
+        printf("Error: Filename is NULL\n");
+        return NULL;
+    }
+
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        printf("Error: Cannot open %s for reading\n", filename);
+        return NULL;
+    }
+
+    int header[3];
+    if (!read_ints(file, header, 3) || header[0] != HUB_LABELS_MAGIC ||
+        header[1] != HUB_LABELS_VERSION || header[2] <= 0 ||
+        header[2] > MAX_VERTICES) {
+        printf("Error: %s is not a hub label file\n", filename);
+        fclose(file);
+        return NULL;
+    }
+
+    int n = header[2];
+    HubLabels* labels = calloc(1, sizeof(HubLabels));
+    bool ok = labels != NULL;
+
+    if (ok) {
+        labels->num_vertices = n;
+        labels->order = malloc(n * sizeof(int));
+        ok = labels->order && read_ints(file, labels->order, n) &&
+             read_label_set(file, &labels->out_labels, n) &&
+             read_label_set(file, &labels->in_labels, n);
+    }
+
+    fclose(file);
+
+    if (!ok) {
+        printf("Error: Failed to read hub labels from %s\n", filename);
+        destroy_hub_labels(labels);
+        return NULL;
+    }
+
+    return labels;
+}
@@ -1,5 +1,6 @@
 #include "../include/graph.h"
 #include "../include/dijkstra.h"
+#include "../include/result_writer.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -87,10 +88,11 @@ void run_dijkstra_all(Graph* graph) {
         scanf(" %c", &choice);
 
         if (choice == 'y' || choice == 'Y') {
-            for (int i = 0; i < graph->num_vertices; i++) {
-                if (i != source) {
-                    print_path(result, source, i);
-                }
+            ResultWriter* writer = create_result_writer(stdout, 0);
+            if (writer) {
+                write_result_tree(writer, result, graph->num_vertices, source,
+                                  RESULT_TEXT);
+                destroy_result_writer(writer);
             }
         }
 
@@ -0,0 +1,261 @@
+#define _GNU_SOURCE
+
+#include "../include/perf_counters.h"
+#include <string.h>
+#include <time.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const char* event_names[PERF_EVENT_COUNT] = {
+    "cycles",
+    "instructions",
+    "L1d misses",
+    "LLC misses",
+    "branch misses",
+    "dTLB misses"
+};
+
+const char* perf_event_name(PerfEvent event) {
+    if ((int)event < 0 || event >= PERF_EVENT_COUNT) {
+        return "unknown";
+    }
+    return event_names[event];
+}
+
+#if defined(__linux__) && defined(SYS_perf_event_open)
+static unsigned long long cache_config(int cache, int result) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+}
+
+/* All events share one group so the kernel schedules them together; a
+ * group that is multiplexed reports enabled and running time, and the
+ * counts are scaled up by their ratio in perf_counters_stop. */
+static int open_event(unsigned int type, unsigned long long config,
+                      int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group_fd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+#endif
+
+/* The first event that opens becomes the group leader; an event the CPU
+ * or kernel does not support is left out of the group and only drops
+ * that column. */
+bool perf_counters_open(PerfCounters* counters) {
+    if (!counters) return false;
+
+    counters->leader = -1;
+    counters->group_size = 0;
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        counters->fds[e] = -1;
+    }
+
+#if defined(__linux__) && defined(SYS_perf_event_open)
+    static const struct {
+        unsigned int type;
+        unsigned long long config;
+    } events[PERF_EVENT_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB}
+    };
+
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        unsigned long long config = events[e].config;
+        if (events[e].type == PERF_TYPE_HW_CACHE) {
+            config = cache_config((int)config, PERF_COUNT_HW_CACHE_RESULT_MISS);
+        }
+
+        int fd = open_event(events[e].type, config, counters->leader);
+        if (fd < 0) {
+            continue;
+        }
+
+        if (counters->leader < 0) {
+            counters->leader = fd;
+        }
+        counters->fds[e] = fd;
+        counters->group_order[counters->group_size++] = (PerfEvent)e;
+    }
+#endif
+
+    return counters->leader >= 0;
+}
+
+void perf_counters_close(PerfCounters* counters) {
+    if (!counters) return;
+
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+#if defined(__linux__)
+        if (counters->fds[e] >= 0) {
+            close(counters->fds[e]);
+        }
+#endif
+        counters->fds[e] = -1;
+    }
+
+    counters->leader = -1;
+    counters->group_size = 0;
+}
+
+void perf_counters_start(PerfCounters* counters) {
+    if (!counters) return;
+
+#if defined(__linux__) && defined(SYS_perf_event_open)
+    if (counters->leader >= 0) {
+        ioctl(counters->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(counters->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+PerfSample perf_counters_stop(PerfCounters* counters) {
+    PerfSample sample;
+    memset(&sample, 0, sizeof(sample));
+
+    if (!counters) return sample;
+
+#if defined(__linux__) && defined(SYS_perf_event_open)
+    if (counters->leader < 0) return sample;
+
+    /* PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, then one
+     * value per member in the order the members were opened. */
+    unsigned long long buffer[3 + PERF_EVENT_COUNT];
+    ioctl(counters->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    ssize_t bytes = read(counters->leader, buffer, sizeof(buffer));
+    if (bytes < (ssize_t)(3 * sizeof(unsigned long long)) ||
+        buffer[0] != (unsigned long long)counters->group_size ||
+        bytes < (ssize_t)((3 + buffer[0]) * sizeof(unsigned long long))) {
+        return sample;
+    }
+
+    unsigned long long enabled = buffer[1];
+    unsigned long long running = buffer[2];
+
+    /* A group that never got onto the PMU has nothing to scale. */
+    if (running == 0) {
+        return sample;
+    }
+
+    for (int i = 0; i < counters->group_size; i++) {
+        PerfEvent e = counters->group_order[i];
+        unsigned long long value = buffer[3 + i];
+
+        if (running < enabled) {
+            value = (unsigned long long)((double)value * enabled / running);
+        }
+
+        sample.values[e] = value;
+        sample.valid[e] = true;
+    }
+#endif
+
+    return sample;
+}
+
+/* Fallback for engines that do not report what they scanned. Exact only
+ * for searches that settle every reachable vertex. */
+static long long count_relaxed_edges(Graph* graph, DijkstraResult result) {
+    long long edges = 0;
+
+    for (int v = 0; v < graph->num_vertices; v++) {
+        if (result.distances[v] != INF) {
+            edges += graph->vertex_degrees[v];
+        }
+    }
+
+    return edges;
+}
+
+/* Counters are enabled only around the engine call itself; counting the
+ * relaxed edges and freeing the result happen outside the window. Engines
+ * that stop early must set stats->edges_relaxed to the edges they scanned;
+ * if it is left negative the reachable out-degree is used instead. */
+bool profile_engine(PerfCounters* counters, DijkstraEngine engine, void* context,
+                    Graph* graph, const int* sources, int num_sources,
+                    PerfReport* report) {
+    if (!counters || !engine || !graph || !sources || !report ||
+        num_sources <= 0) {
+        printf("Error: Invalid input for engine profiling\n");
+        return false;
+    }
+
+    memset(report, 0, sizeof(PerfReport));
+
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        report->totals.valid[e] = counters->fds[e] >= 0;
+    }
+
+    for (int i = 0; i < num_sources; i++) {
+        struct timespec start, end;
+        DijkstraStats stats = {-1, -1, -1};
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        perf_counters_start(counters);
+        DijkstraResult result = engine(context, sources[i], &stats);
+        PerfSample sample = perf_counters_stop(counters);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        if (!result.success) {
+            printf("Error: Engine failed for source %d\n", sources[i]);
+            return false;
+        }
+
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            report->totals.values[e] += sample.values[e];
+            report->totals.valid[e] = report->totals.valid[e] && sample.valid[e];
+        }
+
+        report->edges_relaxed += stats.edges_relaxed >= 0
+                                     ? stats.edges_relaxed
+                                     : count_relaxed_edges(graph, result);
+        report->elapsed_ms += (end.tv_sec - start.tv_sec) * 1000.0 +
+                              (end.tv_nsec - start.tv_nsec) / 1000000.0;
+        report->queries++;
+        free_dijkstra_result(result);
+    }
+
+    return true;
+}
+
+void print_perf_report(const char* name, const PerfReport* report) {
+    if (!report || report->queries == 0) {
+        printf("Error: Empty performance report\n");
+        return;
+    }
+
+    printf("%s: %d queries, %lld edges relaxed, %.3f ms/query\n",
+           name, report->queries, report->edges_relaxed,
+           report->elapsed_ms / report->queries);
+    printf("  %-16s %16s %12s\n", "Counter", "Per query", "Per edge");
+
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        if (!report->totals.valid[e]) {
+            printf("  %-16s %16s %12s\n", event_names[e], "n/a", "n/a");
+            continue;
+        }
+
+        double total = (double)report->totals.values[e];
+        printf("  %-16s %16.1f %12.3f\n", event_names[e],
+               total / report->queries,
+               report->edges_relaxed ? total / report->edges_relaxed : 0.0);
+    }
+}
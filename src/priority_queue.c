@@ -1,4 +1,5 @@
 #include "../include/priority_queue.h"
+#include "../include/allocator.h"
 
 PriorityQueue* create_priority_queue(int capacity) {
     if (capacity <= 0) {
@@ -12,17 +13,17 @@ PriorityQueue* create_priority_queue(int capacity) {
         return NULL;
     }
 
-    pq->heap = malloc(capacity * sizeof(PQNode));
+    pq->heap = policy_alloc(capacity * sizeof(PQNode));
     if (!pq->heap) {
         printf("Error: Memory allocation failed for heap\n");
         free(pq);
         return NULL;
     }
 
-    pq->position = malloc(capacity * sizeof(int));
+    pq->position = policy_alloc(capacity * sizeof(int));
     if (!pq->position) {
         printf("Error: Memory allocation failed for position array\n");
-        free(pq->heap);
+        policy_free(pq->heap);
         free(pq);
         return NULL;
     }
@@ -40,8 +41,8 @@ PriorityQueue* create_priority_queue(int capacity) {
 void destroy_priority_queue(PriorityQueue* pq) {
     if (!pq) return;
 
-    free(pq->heap);
-    free(pq->position);
+    policy_free(pq->heap);
+    policy_free(pq->position);
     free(pq);
 }
 
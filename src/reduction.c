@@ -0,0 +1,698 @@
+#include "../include/reduction.h"
+#include "../include/priority_queue.h"
+#include "../include/dijkstra_kernel.h"
+#include "../include/allocator.h"
+
+/* Chain c holds the interior vertices chain_vertices[chain_offsets[c] ..
+ * chain_offsets[c + 1]) in order from chain_ends[2c] to chain_ends[2c + 1].
+ * A chain with k interior vertices has k + 1 links; the weight of link i
+ * in each direction is stored at chain_offsets[c] + c + i, INF when that
+ * direction has no edge. */
+
+typedef struct NeighborSets {
+    int* offsets;
+    int* counts;
+    int* vertices;
+} NeighborSets;
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static void free_neighbor_sets(NeighborSets* sets) {
+    free(sets->offsets);
+    free(sets->counts);
+    free(sets->vertices);
+}
+
+/* Distinct undirected neighbours of each vertex, ignoring self-loops. */
+static bool build_neighbor_sets(Graph* graph, NeighborSets* sets) {
+    int n = graph->num_vertices;
+
+    sets->offsets = calloc(n + 1, sizeof(int));
+    sets->counts = calloc(n, sizeof(int));
+    sets->vertices = NULL;
+    if (!sets->offsets || !sets->counts) {
+        return false;
+    }
+
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            if (edge->destination != u) {
+                sets->offsets[u + 1]++;
+                sets->offsets[edge->destination + 1]++;
+            }
+        }
+    }
+
+    for (int u = 0; u < n; u++) {
+        sets->offsets[u + 1] += sets->offsets[u];
+    }
+
+    sets->vertices = malloc((sets->offsets[n] + 1) * sizeof(int));
+    if (!sets->vertices) {
+        return false;
+    }
+
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            int v = edge->destination;
+            if (v != u) {
+                sets->vertices[sets->offsets[u] + sets->counts[u]++] = v;
+                sets->vertices[sets->offsets[v] + sets->counts[v]++] = u;
+            }
+        }
+    }
+
+    for (int u = 0; u < n; u++) {
+        int* list = sets->vertices + sets->offsets[u];
+        int unique = 0;
+
+        qsort(list, sets->counts[u], sizeof(int), compare_ints);
+        for (int i = 0; i < sets->counts[u]; i++) {
+            if (unique == 0 || list[unique - 1] != list[i]) {
+                list[unique++] = list[i];
+            }
+        }
+        sets->counts[u] = unique;
+    }
+
+    return true;
+}
+
+static int other_neighbor(const NeighborSets* sets, const bool* removed,
+                          int vertex, int previous) {
+    const int* list = sets->vertices + sets->offsets[vertex];
+
+    for (int i = 0; i < sets->counts[vertex]; i++) {
+        if (!removed[list[i]] && list[i] != previous) {
+            return list[i];
+        }
+    }
+
+    return -1;
+}
+
+/* Follows degree-2 vertices from 'current' (entered from 'previous') until
+ * a core vertex; returns it and the interior vertex just before it. */
+static int walk_to_core(const NeighborSets* sets, const bool* removed,
+                        const bool* is_core, int previous, int current,
+                        int* last) {
+    while (!is_core[current]) {
+        int next = other_neighbor(sets, removed, current, previous);
+        previous = current;
+        current = next;
+    }
+
+    *last = previous;
+    return current;
+}
+
+static int add_weight(int distance, int weight) {
+    if (distance == INF || weight == INF) {
+        return INF;
+    }
+    return distance + weight;
+}
+
+static int chain_left(ReducedGraph* reduced, int chain, int position) {
+    if (position == 0) {
+        return reduced->chain_ends[2 * chain];
+    }
+    return reduced->chain_vertices[reduced->chain_offsets[chain] + position - 1];
+}
+
+static int chain_right(ReducedGraph* reduced, int chain, int position) {
+    int length = reduced->chain_offsets[chain + 1] - reduced->chain_offsets[chain];
+
+    if (position == length - 1) {
+        return reduced->chain_ends[2 * chain + 1];
+    }
+    return reduced->chain_vertices[reduced->chain_offsets[chain] + position + 1];
+}
+
+static void update_link(int* links, int index, int weight) {
+    if (weight < links[index]) {
+        links[index] = weight;
+    }
+}
+
+static void assign_link_weights(ReducedGraph* reduced, Graph* graph) {
+    int total_links = reduced->chain_offsets[reduced->num_chains] +
+                      reduced->num_chains;
+
+    for (int i = 0; i < total_links; i++) {
+        reduced->chain_forward[i] = INF;
+        reduced->chain_backward[i] = INF;
+    }
+
+    for (int x = 0; x < graph->num_vertices; x++) {
+        for (Edge* edge = graph->adjacency_list[x]; edge; edge = edge->next) {
+            int y = edge->destination;
+
+            if (reduced->chain_of[x] >= 0) {
+                int c = reduced->chain_of[x];
+                int i = reduced->chain_position[x];
+                int base = reduced->chain_offsets[c] + c;
+
+                if (y == chain_right(reduced, c, i)) {
+                    update_link(reduced->chain_forward, base + i + 1, edge->weight);
+                } else if (y == chain_left(reduced, c, i)) {
+                    update_link(reduced->chain_backward, base + i, edge->weight);
+                }
+            }
+
+            if (reduced->chain_of[y] >= 0) {
+                int c = reduced->chain_of[y];
+                int j = reduced->chain_position[y];
+                int base = reduced->chain_offsets[c] + c;
+
+                if (x == chain_left(reduced, c, j)) {
+                    update_link(reduced->chain_forward, base + j, edge->weight);
+                } else if (x == chain_right(reduced, c, j)) {
+                    update_link(reduced->chain_backward, base + j + 1, edge->weight);
+                }
+            }
+        }
+    }
+}
+
+static int chain_total(const int* links, int base, int count) {
+    int total = 0;
+
+    for (int i = 0; i < count; i++) {
+        total = add_weight(total, links[base + i]);
+    }
+
+    return total;
+}
+
+/* Core arcs are the original edges between core vertices plus one
+ * shortcut per chain direction; core_via records the vertex preceding
+ * the arc's target in the original graph (-1 for a plain edge). */
+static void build_core_arcs(ReducedGraph* reduced, Graph* graph, int pass) {
+    for (int u = 0; u < graph->num_vertices; u++) {
+        int cu = reduced->core_index[u];
+        if (cu < 0) continue;
+
+        for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+            int cv = reduced->core_index[edge->destination];
+            if (cv < 0 || cv == cu) continue;
+
+            if (pass == 0) {
+                reduced->core_offsets[cu + 1]++;
+            } else {
+                int slot = reduced->core_offsets[cu]++;
+                reduced->core_targets[slot] = cv;
+                reduced->core_weights[slot] = edge->weight;
+                reduced->core_via[slot] = -1;
+            }
+        }
+    }
+
+    for (int c = 0; c < reduced->num_chains; c++) {
+        int first = reduced->chain_offsets[c];
+        int length = reduced->chain_offsets[c + 1] - first;
+        int base = first + c;
+        int ca = reduced->core_index[reduced->chain_ends[2 * c]];
+        int cb = reduced->core_index[reduced->chain_ends[2 * c + 1]];
+        int forward = chain_total(reduced->chain_forward, base, length + 1);
+        int backward = chain_total(reduced->chain_backward, base, length + 1);
+
+        if (forward != INF) {
+            if (pass == 0) {
+                reduced->core_offsets[ca + 1]++;
+            } else {
+                int slot = reduced->core_offsets[ca]++;
+                reduced->core_targets[slot] = cb;
+                reduced->core_weights[slot] = forward;
+                reduced->core_via[slot] = reduced->chain_vertices[first + length - 1];
+            }
+        }
+
+        if (backward != INF) {
+            if (pass == 0) {
+                reduced->core_offsets[cb + 1]++;
+            } else {
+                int slot = reduced->core_offsets[cb]++;
+                reduced->core_targets[slot] = ca;
+                reduced->core_weights[slot] = backward;
+                reduced->core_via[slot] = reduced->chain_vertices[first];
+            }
+        }
+    }
+}
+
+static bool build_core(ReducedGraph* reduced, Graph* graph) {
+    int num_core = reduced->num_core;
+
+    reduced->core_offsets = calloc(num_core + 1, sizeof(int));
+    if (!reduced->core_offsets) {
+        return false;
+    }
+
+    build_core_arcs(reduced, graph, 0);
+    for (int c = 0; c < num_core; c++) {
+        reduced->core_offsets[c + 1] += reduced->core_offsets[c];
+    }
+
+    int num_arcs = reduced->core_offsets[num_core];
+    reduced->core_targets = malloc((num_arcs + 1) * sizeof(int));
+    reduced->core_weights = malloc((num_arcs + 1) * sizeof(int));
+    reduced->core_via = malloc((num_arcs + 1) * sizeof(int));
+    if (!reduced->core_targets || !reduced->core_weights || !reduced->core_via) {
+        return false;
+    }
+
+    /* The fill pass advances each offset to the start of the next vertex;
+     * shifting back restores the CSR layout. */
+    build_core_arcs(reduced, graph, 1);
+    for (int c = num_core; c > 0; c--) {
+        reduced->core_offsets[c] = reduced->core_offsets[c - 1];
+    }
+    reduced->core_offsets[0] = 0;
+
+    return true;
+}
+
+static int prune_trees(ReducedGraph* reduced, const NeighborSets* sets,
+                       int* remaining, bool* removed, int* stack) {
+    int n = reduced->num_vertices;
+    int top = 0;
+
+    for (int v = 0; v < n; v++) {
+        remaining[v] = sets->counts[v];
+        if (remaining[v] <= 1) {
+            stack[top++] = v;
+        }
+    }
+
+    /* A vertex with a single neighbour is a dead end: any path through it
+     * would return to that neighbour, so removing it leaves every other
+     * distance unchanged. */
+    while (top > 0) {
+        int v = stack[--top];
+        removed[v] = true;
+
+        int parent = other_neighbor(sets, removed, v, -1);
+        reduced->pruned_order[reduced->num_pruned++] = v;
+        reduced->pruned_parent[v] = parent;
+
+        if (parent >= 0 && --remaining[parent] == 1) {
+            stack[top++] = parent;
+        }
+    }
+
+    return reduced->num_pruned;
+}
+
+static void contract_chains(ReducedGraph* reduced, const NeighborSets* sets,
+                            const int* remaining, const bool* removed,
+                            bool* is_core, bool* visited) {
+    int n = reduced->num_vertices;
+
+    for (int v = 0; v < n; v++) {
+        is_core[v] = !removed[v] && remaining[v] != 2;
+    }
+
+    /* A cycle made only of degree-2 vertices has no core vertex to end a
+     * chain at, so one of its vertices is kept in the core. Otherwise the
+     * walk reached one end, and the other side of v is marked as well so
+     * that no interior vertex of this chain starts a walk of its own. */
+    for (int v = 0; v < n; v++) {
+        if (removed[v] || is_core[v] || visited[v]) continue;
+
+        int first = other_neighbor(sets, removed, v, -1);
+        int previous = v;
+        int current = first;
+        visited[v] = true;
+
+        while (current != v && !is_core[current]) {
+            visited[current] = true;
+            int next = other_neighbor(sets, removed, current, previous);
+            previous = current;
+            current = next;
+        }
+
+        if (current == v) {
+            is_core[v] = true;
+            continue;
+        }
+
+        previous = v;
+        current = other_neighbor(sets, removed, v, first);
+        while (!is_core[current]) {
+            visited[current] = true;
+            int next = other_neighbor(sets, removed, current, previous);
+            previous = current;
+            current = next;
+        }
+    }
+
+    for (int v = 0; v < n; v++) {
+        reduced->chain_of[v] = -1;
+        reduced->core_index[v] = -1;
+        if (is_core[v]) {
+            reduced->core_index[v] = reduced->num_core;
+            reduced->core_vertices[reduced->num_core++] = v;
+        }
+    }
+
+    int filled = 0;
+    for (int v = 0; v < n; v++) {
+        if (removed[v] || is_core[v] || reduced->chain_of[v] >= 0) continue;
+
+        int c = reduced->num_chains++;
+        int last;
+        int start = walk_to_core(sets, removed, is_core, v,
+                                 other_neighbor(sets, removed, v, -1), &last);
+
+        /* If the first neighbour was itself the core end, the walk stops
+         * immediately with v as the interior vertex next to it. */
+        int previous = start;
+        int current = last;
+
+        reduced->chain_offsets[c] = filled;
+        while (!is_core[current]) {
+            reduced->chain_of[current] = c;
+            reduced->chain_position[current] = filled - reduced->chain_offsets[c];
+            reduced->chain_vertices[filled++] = current;
+
+            int next = other_neighbor(sets, removed, current, previous);
+            previous = current;
+            current = next;
+        }
+
+        reduced->chain_ends[2 * c] = start;
+        reduced->chain_ends[2 * c + 1] = current;
+    }
+    reduced->chain_offsets[reduced->num_chains] = filled;
+}
+
+ReducedGraph* reduce_graph(Graph* graph) {
+    if (!graph || graph->num_vertices <= 0) {
+        printf("Error: Invalid graph for reduction\n");
+        return NULL;
+    }
+
+    int n = graph->num_vertices;
+    ReducedGraph* reduced = calloc(1, sizeof(ReducedGraph));
+    if (!reduced) {
+        printf("Error: Memory allocation failed for reduced graph\n");
+        return NULL;
+    }
+
+    reduced->original = graph;
+    reduced->num_vertices = n;
+    reduced->core_index = malloc(n * sizeof(int));
+    reduced->core_vertices = malloc(n * sizeof(int));
+    reduced->chain_of = malloc(n * sizeof(int));
+    reduced->chain_position = malloc(n * sizeof(int));
+    reduced->chain_offsets = malloc((n + 1) * sizeof(int));
+    reduced->chain_vertices = malloc(n * sizeof(int));
+    reduced->chain_ends = malloc(2 * n * sizeof(int));
+    reduced->chain_forward = malloc(2 * n * sizeof(int));
+    reduced->chain_backward = malloc(2 * n * sizeof(int));
+    reduced->pruned_order = malloc(n * sizeof(int));
+    reduced->pruned_parent = malloc(n * sizeof(int));
+    reduced->pruned_weight = malloc(n * sizeof(int));
+
+    NeighborSets sets;
+    int* remaining = malloc(n * sizeof(int));
+    int* stack = malloc(n * sizeof(int));
+    bool* removed = calloc(n, sizeof(bool));
+    bool* is_core = calloc(n, sizeof(bool));
+    bool* visited = calloc(n, sizeof(bool));
+
+    bool ok = build_neighbor_sets(graph, &sets) && remaining && stack &&
+              removed && is_core && visited && reduced->core_index && reduced->core_vertices &&
+              reduced->chain_of && reduced->chain_position &&
+              reduced->chain_offsets && reduced->chain_vertices &&
+              reduced->chain_ends && reduced->chain_forward &&
+              reduced->chain_backward && reduced->pruned_order &&
+              reduced->pruned_parent && reduced->pruned_weight;
+
+    if (ok) {
+        prune_trees(reduced, &sets, remaining, removed, stack);
+        contract_chains(reduced, &sets, remaining, removed, is_core, visited);
+    }
+
+    if (ok) {
+        for (int v = 0; v < n; v++) {
+            reduced->pruned_weight[v] = INF;
+        }
+
+        for (int u = 0; u < n; u++) {
+            for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+                int v = edge->destination;
+                if (removed[v] && reduced->pruned_parent[v] == u &&
+                    edge->weight < reduced->pruned_weight[v]) {
+                    reduced->pruned_weight[v] = edge->weight;
+                }
+            }
+        }
+
+        assign_link_weights(reduced, graph);
+        ok = build_core(reduced, graph);
+    }
+
+    free_neighbor_sets(&sets);
+    free(remaining);
+    free(stack);
+    free(removed);
+    free(is_core);
+    free(visited);
+
+    if (!ok) {
+        printf("Error: Memory allocation failed for graph reduction\n");
+        destroy_reduced_graph(reduced);
+        return NULL;
+    }
+
+    return reduced;
+}
+
+void destroy_reduced_graph(ReducedGraph* reduced) {
+    if (!reduced) return;
+
+    free(reduced->core_index);
+    free(reduced->core_vertices);
+    free(reduced->core_offsets);
+    free(reduced->core_targets);
+    free(reduced->core_weights);
+    free(reduced->core_via);
+    free(reduced->chain_of);
+    free(reduced->chain_position);
+    free(reduced->chain_offsets);
+    free(reduced->chain_vertices);
+    free(reduced->chain_ends);
+    free(reduced->chain_forward);
+    free(reduced->chain_backward);
+    free(reduced->pruned_order);
+    free(reduced->pruned_parent);
+    free(reduced->pruned_weight);
+    free(reduced);
+}
+
+static void seed_core(PriorityQueue* pq, int* distances, int* parents,
+                      int vertex, int distance, int parent) {
+    if (distance >= distances[vertex]) {
+        return;
+    }
+
+    if (is_in_queue(pq, vertex)) {
+        decrease_key(pq, vertex, distance);
+    } else {
+        insert(pq, vertex, distance);
+    }
+    distances[vertex] = distance;
+    parents[vertex] = parent;
+}
+
+/* A core arc that contracts a chain records the chain vertex next to its
+ * head as the parent; a plain core edge records its tail. */
+#define FOR_EACH_CORE_EDGE(reduced, u, neighbor, weight, parent)            \
+    for (int arc_ = (reduced)->core_offsets[u];                             \
+         arc_ < (reduced)->core_offsets[(u) + 1] &&                         \
+         ((neighbor) = (reduced)->core_targets[arc_],                       \
+          (weight) = (reduced)->core_weights[arc_],                         \
+          (parent) = (reduced)->core_via[arc_] >= 0                         \
+                         ? (reduced)->core_via[arc_]                        \
+                         : (reduced)->core_vertices[u], 1);                 \
+         arc_++)
+
+DIJKSTRA_KERNEL(search_core, ReducedGraph, FOR_EACH_CORE_EDGE, 1, 0, STOP_NONE, 1)
+
+static void relax_interior(DijkstraResult result, int vertex, int distance,
+                           int parent) {
+    if (distance < result.distances[vertex]) {
+        result.distances[vertex] = distance;
+        result.parents[vertex] = parent;
+    }
+}
+
+static void expand_chain(ReducedGraph* reduced, DijkstraResult result,
+                         int chain, int source) {
+    int first = reduced->chain_offsets[chain];
+    int length = reduced->chain_offsets[chain + 1] - first;
+    int base = first + chain;
+    const int* vertices = reduced->chain_vertices + first;
+    const int* forward = reduced->chain_forward;
+    const int* backward = reduced->chain_backward;
+
+    /* A source inside this chain reaches its neighbours directly; these
+     * are set first so that ties never route back through the ends. */
+    if (reduced->chain_of[source] == chain) {
+        int position = reduced->chain_position[source];
+        int distance = 0;
+
+        for (int i = position + 1; i < length; i++) {
+            distance = add_weight(distance, forward[base + i]);
+            relax_interior(result, vertices[i], distance, vertices[i - 1]);
+        }
+
+        distance = 0;
+        for (int i = position - 1; i >= 0; i--) {
+            distance = add_weight(distance, backward[base + i + 1]);
+            relax_interior(result, vertices[i], distance, vertices[i + 1]);
+        }
+    }
+
+    /* An end reached through this very chain cannot improve it, and with
+     * zero-weight links propagating from it could close a parent cycle. */
+    int start = reduced->chain_ends[2 * chain];
+    if (result.parents[start] != vertices[0]) {
+        int distance = result.distances[start];
+        for (int i = 0; i < length; i++) {
+            distance = add_weight(distance, forward[base + i]);
+            relax_interior(result, vertices[i], distance,
+                           chain_left(reduced, chain, i));
+        }
+    }
+
+    int end = reduced->chain_ends[2 * chain + 1];
+    if (result.parents[end] != vertices[length - 1]) {
+        int distance = result.distances[end];
+        for (int i = length - 1; i >= 0; i--) {
+            distance = add_weight(distance, backward[base + i + 1]);
+            relax_interior(result, vertices[i], distance,
+                           chain_right(reduced, chain, i));
+        }
+    }
+}
+
+DijkstraResult dijkstra_reduced(ReducedGraph* reduced, int source) {
+    DijkstraResult result = {NULL, NULL, false};
+
+    if (!reduced || !validate_dijkstra_input(reduced->original, source)) {
+        printf("Error: Invalid input for reduced Dijkstra\n");
+        return result;
+    }
+
+    /* Queries starting inside a pruned tree can leave it only through its
+     * root, so they are answered on the original graph. */
+    if (reduced->core_index[source] < 0 && reduced->chain_of[source] < 0) {
+        return dijkstra(reduced->original, source);
+    }
+
+    int n = reduced->num_vertices;
+    int num_core = reduced->num_core;
+
+    result.distances = policy_alloc(n * sizeof(int));
+    result.parents = policy_alloc(n * sizeof(int));
+    int* core_distances = malloc(num_core * sizeof(int));
+    int* core_parents = malloc(num_core * sizeof(int));
+
+    if (!result.distances || !result.parents || !core_distances ||
+        !core_parents) {
+        printf("Error: Memory allocation failed\n");
+        free(core_distances);
+        free(core_parents);
+        free_dijkstra_result(result);
+        result.distances = NULL;
+        result.parents = NULL;
+        return result;
+    }
+
+    PriorityQueue* pq = create_priority_queue(num_core);
+    if (!pq) {
+        printf("Error: Failed to create priority queue\n");
+        free(core_distances);
+        free(core_parents);
+        free_dijkstra_result(result);
+        result.distances = NULL;
+        result.parents = NULL;
+        return result;
+    }
+
+    for (int c = 0; c < num_core; c++) {
+        core_distances[c] = INF;
+        core_parents[c] = -1;
+    }
+
+    if (reduced->core_index[source] >= 0) {
+        seed_core(pq, core_distances, core_parents,
+                  reduced->core_index[source], 0, -1);
+    } else {
+        /* A source inside a chain enters the core through both chain
+         * ends, at the distance along the chain in each direction. */
+        int chain = reduced->chain_of[source];
+        int position = reduced->chain_position[source];
+        int first = reduced->chain_offsets[chain];
+        int length = reduced->chain_offsets[chain + 1] - first;
+        int base = first + chain;
+
+        seed_core(pq, core_distances, core_parents,
+                  reduced->core_index[reduced->chain_ends[2 * chain]],
+                  chain_total(reduced->chain_backward, base, position + 1),
+                  reduced->chain_vertices[first]);
+        seed_core(pq, core_distances, core_parents,
+                  reduced->core_index[reduced->chain_ends[2 * chain + 1]],
+                  chain_total(reduced->chain_forward, base + position + 1,
+                              length - position),
+                  reduced->chain_vertices[first + length - 1]);
+    }
+
+    DijkstraSearch search = {pq, core_distances, core_parents, -1, NULL, 0,
+                             true, NULL};
+    search_core(reduced, &search);
+
+    for (int v = 0; v < n; v++) {
+        result.distances[v] = INF;
+        result.parents[v] = -1;
+    }
+
+    for (int c = 0; c < num_core; c++) {
+        result.distances[reduced->core_vertices[c]] = core_distances[c];
+        result.parents[reduced->core_vertices[c]] = core_parents[c];
+    }
+
+    result.distances[source] = 0;
+    result.parents[source] = -1;
+
+    for (int c = 0; c < reduced->num_chains; c++) {
+        expand_chain(reduced, result, c, source);
+    }
+
+    for (int i = reduced->num_pruned - 1; i >= 0; i--) {
+        int v = reduced->pruned_order[i];
+        int parent = reduced->pruned_parent[v];
+
+        if (parent >= 0) {
+            int distance = add_weight(result.distances[parent],
+                                      reduced->pruned_weight[v]);
+            if (distance != INF) {
+                result.distances[v] = distance;
+                result.parents[v] = parent;
+            }
+        }
+    }
+
+    destroy_priority_queue(pq);
+    free(core_distances);
+    free(core_parents);
+    result.success = true;
+    return result;
+}
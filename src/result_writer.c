@@ -0,0 +1,336 @@
+#include "../include/result_writer.h"
+#include "../include/allocator.h"
+#include <string.h>
+
+#define RESULT_BINARY_MAGIC 0x52534A44
+#define RESULT_BINARY_VERSION 1
+
+static const char digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+ResultWriter* create_result_writer(FILE* stream, size_t capacity) {
+    if (!stream) {
+        printf("Error: Output stream is NULL\n");
+        return NULL;
+    }
+
+    ResultWriter* writer = malloc(sizeof(ResultWriter));
+    if (!writer) {
+        printf("Error: Memory allocation failed for result writer\n");
+        return NULL;
+    }
+
+    writer->capacity = capacity > 0 ? capacity : RESULT_WRITER_BUFFER;
+    writer->buffer = malloc(writer->capacity);
+    if (!writer->buffer) {
+        printf("Error: Memory allocation failed for writer buffer\n");
+        free(writer);
+        return NULL;
+    }
+
+    writer->stream = stream;
+    writer->length = 0;
+    writer->failed = false;
+    return writer;
+}
+
+bool flush_result_writer(ResultWriter* writer) {
+    if (!writer) return false;
+
+    if (writer->length > 0 && !writer->failed &&
+        fwrite(writer->buffer, 1, writer->length, writer->stream) != writer->length) {
+        writer->failed = true;
+    }
+    writer->length = 0;
+
+    if (!writer->failed && fflush(writer->stream) != 0) {
+        writer->failed = true;
+    }
+    return !writer->failed;
+}
+
+bool destroy_result_writer(ResultWriter* writer) {
+    if (!writer) return false;
+
+    bool ok = flush_result_writer(writer);
+    free(writer->buffer);
+    free(writer);
+    return ok;
+}
+
+void writer_put(ResultWriter* writer, const char* data, size_t length) {
+    if (writer->failed) return;
+
+    if (length > writer->capacity - writer->length) {
+        if (writer->length > 0 &&
+            fwrite(writer->buffer, 1, writer->length, writer->stream) != writer->length) {
+            writer->failed = true;
+            return;
+        }
+        writer->length = 0;
+
+        if (length > writer->capacity) {
+            if (fwrite(data, 1, length, writer->stream) != length) {
+                writer->failed = true;
+            }
+            return;
+        }
+    }
+
+    memcpy(writer->buffer + writer->length, data, length);
+    writer->length += length;
+}
+
+/* Writes the decimal form of value to out (at most 11 bytes, no
+ * terminator), two digits per division; returns its length. */
+int format_int(char* out, int value) {
+    char digits[12];
+    int pos = sizeof(digits);
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value
+                                       : (unsigned int)value;
+
+    while (magnitude >= 100) {
+        unsigned int pair = (magnitude % 100) * 2;
+        magnitude /= 100;
+        digits[--pos] = digit_pairs[pair + 1];
+        digits[--pos] = digit_pairs[pair];
+    }
+
+    if (magnitude >= 10) {
+        digits[--pos] = digit_pairs[magnitude * 2 + 1];
+        digits[--pos] = digit_pairs[magnitude * 2];
+    } else {
+        digits[--pos] = (char)('0' + magnitude);
+    }
+
+    if (value < 0) {
+        digits[--pos] = '-';
+    }
+
+    int length = (int)sizeof(digits) - pos;
+    memcpy(out, digits + pos, length);
+    return length;
+}
+
+void writer_put_int(ResultWriter* writer, int value) {
+    char digits[12];
+    writer_put(writer, digits, format_int(digits, value));
+}
+
+#define PUT_LITERAL(writer, text) writer_put(writer, text, sizeof(text) - 1)
+
+static bool write_binary(ResultWriter* writer, DijkstraResult result,
+                         int num_vertices, int source) {
+    int header[4] = {RESULT_BINARY_MAGIC, RESULT_BINARY_VERSION,
+                     num_vertices, source};
+
+    writer_put(writer, (const char*)header, sizeof(header));
+    writer_put(writer, (const char*)result.distances, num_vertices * sizeof(int));
+    writer_put(writer, (const char*)result.parents, num_vertices * sizeof(int));
+    return !writer->failed;
+}
+
+static bool write_json_lines(ResultWriter* writer, DijkstraResult result,
+                             int num_vertices, int source) {
+    for (int v = 0; v < num_vertices; v++) {
+        PUT_LITERAL(writer, "{\"source\":");
+        writer_put_int(writer, source);
+        PUT_LITERAL(writer, ",\"vertex\":");
+        writer_put_int(writer, v);
+        PUT_LITERAL(writer, ",\"distance\":");
+        if (result.distances[v] == INF) {
+            PUT_LITERAL(writer, "null");
+        } else {
+            writer_put_int(writer, result.distances[v]);
+        }
+        PUT_LITERAL(writer, ",\"parent\":");
+        writer_put_int(writer, result.parents[v]);
+        PUT_LITERAL(writer, "}\n");
+    }
+
+    return !writer->failed;
+}
+
+static void put_path_line(ResultWriter* writer, int source, int vertex,
+                          int distance, const char* path, size_t length) {
+    PUT_LITERAL(writer, "Path from ");
+    writer_put_int(writer, source);
+    PUT_LITERAL(writer, " to ");
+    writer_put_int(writer, vertex);
+    PUT_LITERAL(writer, " (distance: ");
+    writer_put_int(writer, distance);
+    PUT_LITERAL(writer, "): ");
+    writer_put(writer, path, length);
+    PUT_LITERAL(writer, "\n");
+}
+
+/* One depth-first walk of the shortest-path tree. The textual path of the
+ * vertex on top of the stack is kept in a single prefix buffer, so each
+ * line costs one copy of that prefix instead of a walk up the parents. */
+static bool write_text(ResultWriter* writer, DijkstraResult result,
+                       int num_vertices, int source) {
+    int* child_offsets = calloc(num_vertices + 1, sizeof(int));
+    int* children = malloc(num_vertices * sizeof(int));
+    int* stack_vertex = malloc(num_vertices * sizeof(int));
+    int* stack_cursor = malloc(num_vertices * sizeof(int));
+    size_t* stack_length = malloc(num_vertices * sizeof(size_t));
+    size_t prefix_capacity = 4096;
+    char* prefix = malloc(prefix_capacity);
+
+    if (!child_offsets || !children || !stack_vertex || !stack_cursor ||
+        !stack_length || !prefix) {
+        printf("Error: Memory allocation failed for result export\n");
+        free(child_offsets);
+        free(children);
+        free(stack_vertex);
+        free(stack_cursor);
+        free(stack_length);
+        free(prefix);
+        return false;
+    }
+
+    for (int v = 0; v < num_vertices; v++) {
+        int parent = result.parents[v];
+        if (v != source && result.distances[v] != INF &&
+            parent >= 0 && parent < num_vertices) {
+            child_offsets[parent + 1]++;
+        }
+    }
+
+    for (int v = 0; v < num_vertices; v++) {
+        child_offsets[v + 1] += child_offsets[v];
+    }
+
+    for (int v = 0; v < num_vertices; v++) {
+        stack_cursor[v] = child_offsets[v];
+    }
+    for (int v = 0; v < num_vertices; v++) {
+        int parent = result.parents[v];
+        if (v != source && result.distances[v] != INF &&
+            parent >= 0 && parent < num_vertices) {
+            children[stack_cursor[parent]++] = v;
+        }
+    }
+
+    bool ok = true;
+    int top = 1;
+
+    stack_vertex[0] = source;
+    stack_cursor[0] = child_offsets[source];
+    stack_length[0] = format_int(prefix, source);
+
+    while (top > 0 && ok) {
+        int frame = top - 1;
+        int vertex = stack_vertex[frame];
+
+        if (stack_cursor[frame] == child_offsets[vertex + 1]) {
+            top--;
+            continue;
+        }
+
+        int child = children[stack_cursor[frame]++];
+        size_t length = stack_length[frame];
+
+        if (length + 16 > prefix_capacity) {
+            char* grown = realloc(prefix, prefix_capacity * 2);
+            if (!grown) {
+                printf("Error: Memory allocation failed for result export\n");
+                ok = false;
+                break;
+            }
+            prefix = grown;
+            prefix_capacity *= 2;
+        }
+
+        memcpy(prefix + length, " -> ", 4);
+        length += 4;
+        length += format_int(prefix + length, child);
+
+        put_path_line(writer, source, child, result.distances[child],
+                      prefix, length);
+
+        stack_vertex[top] = child;
+        stack_cursor[top] = child_offsets[child];
+        stack_length[top] = length;
+        top++;
+    }
+
+    for (int v = 0; v < num_vertices && ok; v++) {
+        if (v != source && result.distances[v] == INF) {
+            PUT_LITERAL(writer, "No path from ");
+            writer_put_int(writer, source);
+            PUT_LITERAL(writer, " to ");
+            writer_put_int(writer, v);
+            PUT_LITERAL(writer, "\n");
+        }
+    }
+
+    free(child_offsets);
+    free(children);
+    free(stack_vertex);
+    free(stack_cursor);
+    free(stack_length);
+    free(prefix);
+    return ok && !writer->failed;
+}
+
+bool write_result_tree(ResultWriter* writer, DijkstraResult result,
+                       int num_vertices, int source, ResultFormat format) {
+    if (!writer || !result.success || !result.distances || !result.parents ||
+        num_vertices <= 0 || source < 0 || source >= num_vertices) {
+        printf("Error: Invalid input for result export\n");
+        return false;
+    }
+
+    switch (format) {
+    case RESULT_TEXT:
+        return write_text(writer, result, num_vertices, source);
+    case RESULT_JSON_LINES:
+        return write_json_lines(writer, result, num_vertices, source);
+    case RESULT_BINARY:
+        return write_binary(writer, result, num_vertices, source);
+    default:
+        printf("Error: Unknown result format\n");
+        return false;
+    }
+}
+
+DijkstraResult read_result_binary(FILE* stream, int* num_vertices, int* source) {
+    DijkstraResult result = {NULL, NULL, false};
+    int header[4];
+
+    if (!stream || !num_vertices || !source) {
+        printf("Error: Invalid input for result import\n");
+        return result;
+    }
+
+    if (fread(header, sizeof(int), 4, stream) != 4 ||
+        header[0] != RESULT_BINARY_MAGIC || header[1] != RESULT_BINARY_VERSION ||
+        header[2] <= 0 || header[3] < 0 || header[3] >= header[2]) {
+        printf("Error: Stream does not contain a binary result\n");
+        return result;
+    }
+
+    size_t n = (size_t)header[2];
+    result.distances = policy_alloc(n * sizeof(int));
+    result.parents = policy_alloc(n * sizeof(int));
+
+    if (!result.distances || !result.parents ||
+        fread(result.distances, sizeof(int), n, stream) != n ||
+        fread(result.parents, sizeof(int), n, stream) != n) {
+        printf("Error: Failed to read binary result\n");
+        free_dijkstra_result(result);
+        result.distances = NULL;
+        result.parents = NULL;
+        return result;
+    }
+
+    *num_vertices = header[2];
+    *source = header[3];
+    result.success = true;
+    return result;
+}
@@ -0,0 +1,200 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/versioned_graph.h"
+
+/* Readers announce the global epoch they entered in before loading the
+ * current version. A writer swaps the version pointer, then advances the
+ * epoch; the old version is freed once no active reader announced an
+ * epoch older than the swap, so readers never wait on writers. */
+
+static GraphVersion* create_version(Graph* graph, unsigned long version) {
+    GraphVersion* entry = malloc(sizeof(GraphVersion));
+    if (!entry) {
+        return NULL;
+    }
+
+    entry->graph = graph;
+    entry->version = version;
+    entry->retired_epoch = 0;
+    entry->next_retired = NULL;
+    return entry;
+}
+
+static void destroy_version(GraphVersion* entry) {
+    destroy_graph(entry->graph);
+    free(entry);
+}
+
+static int reclaim_locked(VersionedGraph* versioned) {
+    unsigned long oldest = __atomic_load_n(&versioned->global_epoch,
+                                           __ATOMIC_SEQ_CST);
+    for (int i = 0; i < MAX_READERS; i++) {
+        unsigned long epoch = __atomic_load_n(&versioned->readers[i].epoch,
+                                              __ATOMIC_SEQ_CST);
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    int pending = 0;
+    GraphVersion** link = &versioned->retired;
+    while (*link) {
+        GraphVersion* entry = *link;
+        if (entry->retired_epoch <= oldest) {
+            *link = entry->next_retired;
+            destroy_version(entry);
+        } else {
+            link = &entry->next_retired;
+            pending++;
+        }
+    }
+
+    return pending;
+}
+
+VersionedGraph* create_versioned_graph(Graph* initial) {
+    if (!initial) {
+        printf("Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    VersionedGraph* versioned = calloc(1, sizeof(VersionedGraph));
+    if (!versioned) {
+        printf("Error: Memory allocation failed for versioned graph\n");
+        return NULL;
+    }
+
+    versioned->current = create_version(initial, 1);
+    if (!versioned->current) {
+        printf("Error: Memory allocation failed for graph version\n");
+        free(versioned);
+        return NULL;
+    }
+
+    versioned->global_epoch = 1;
+    pthread_mutex_init(&versioned->writer_lock, NULL);
+    return versioned;
+}
+
+void destroy_versioned_graph(VersionedGraph* versioned) {
+    if (!versioned) return;
+
+    GraphVersion* entry = versioned->retired;
+    while (entry) {
+        GraphVersion* next = entry->next_retired;
+        destroy_version(entry);
+        entry = next;
+    }
+
+    destroy_version(versioned->current);
+    pthread_mutex_destroy(&versioned->writer_lock);
+    free(versioned);
+}
+
+int register_reader(VersionedGraph* versioned) {
+    if (!versioned) return -1;
+
+    for (int i = 0; i < MAX_READERS; i++) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&versioned->readers[i].in_use,
+                                        &expected, 1, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            __atomic_store_n(&versioned->readers[i].epoch, 0, __ATOMIC_SEQ_CST);
+            return i;
+        }
+    }
+
+    printf("Error: No free reader slots\n");
+    return -1;
+}
+
+void unregister_reader(VersionedGraph* versioned, int reader) {
+    if (!versioned || reader < 0 || reader >= MAX_READERS) return;
+
+    __atomic_store_n(&versioned->readers[reader].epoch, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&versioned->readers[reader].in_use, 0, __ATOMIC_SEQ_CST);
+}
+
+Graph* acquire_snapshot(VersionedGraph* versioned, int reader) {
+    if (!versioned || reader < 0 || reader >= MAX_READERS) {
+        printf("Error: Invalid reader\n");
+        return NULL;
+    }
+
+    unsigned long epoch = __atomic_load_n(&versioned->global_epoch,
+                                          __ATOMIC_SEQ_CST);
+    __atomic_store_n(&versioned->readers[reader].epoch, epoch, __ATOMIC_SEQ_CST);
+
+    GraphVersion* entry = __atomic_load_n(&versioned->current, __ATOMIC_SEQ_CST);
+    return entry->graph;
+}
+
+void release_snapshot(VersionedGraph* versioned, int reader) {
+    if (!versioned || reader < 0 || reader >= MAX_READERS) return;
+
+    __atomic_store_n(&versioned->readers[reader].epoch, 0, __ATOMIC_RELEASE);
+}
+
+Graph* begin_update(VersionedGraph* versioned) {
+    if (!versioned) {
+        printf("Error: Versioned graph is NULL\n");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&versioned->writer_lock);
+
+    Graph* next = copy_graph(versioned->current->graph);
+    if (!next) {
+        pthread_mutex_unlock(&versioned->writer_lock);
+    }
+    return next;
+}
+
+bool publish_update(VersionedGraph* versioned, Graph* next) {
+    if (!versioned || !next) {
+        printf("Error: Invalid input for publishing graph update\n");
+        return false;
+    }
+
+    GraphVersion* entry = create_version(next, versioned->current->version + 1);
+    if (!entry) {
+        printf("Error: Memory allocation failed for graph version\n");
+        destroy_graph(next);
+        pthread_mutex_unlock(&versioned->writer_lock);
+        return false;
+    }
+
+    GraphVersion* old = __atomic_exchange_n(&versioned->current, entry,
+                                            __ATOMIC_SEQ_CST);
+    old->retired_epoch = __atomic_add_fetch(&versioned->global_epoch, 1,
+                                            __ATOMIC_SEQ_CST);
+    old->next_retired = versioned->retired;
+    versioned->retired = old;
+
+    reclaim_locked(versioned);
+    pthread_mutex_unlock(&versioned->writer_lock);
+    return true;
+}
+
+void abort_update(VersionedGraph* versioned, Graph* next) {
+    if (!versioned) return;
+
+    destroy_graph(next);
+    pthread_mutex_unlock(&versioned->writer_lock);
+}
+
+unsigned long current_version(VersionedGraph* versioned) {
+    if (!versioned) return 0;
+
+    GraphVersion* entry = __atomic_load_n(&versioned->current, __ATOMIC_SEQ_CST);
+    return entry->version;
+}
+
+int reclaim_versions(VersionedGraph* versioned) {
+    if (!versioned) return 0;
+
+    pthread_mutex_lock(&versioned->writer_lock);
+    int pending = reclaim_locked(versioned);
+    pthread_mutex_unlock(&versioned->writer_lock);
+    return pending;
+}
@@ -1,9 +1,39 @@
 #include "../include/graph.h"
 #include "../include/dijkstra.h"
+#include "../include/crp.h"
+#include "../include/hub_labels.h"
+#include "../include/compressed_graph.h"
+#include "../include/allocator.h"
+#include "../include/versioned_graph.h"
+#include "../include/perf_counters.h"
+#include "../include/dijkstra_batch.h"
+#include "../include/reduction.h"
+#include "../include/dijkstra_interleaved.h"
+#include "../include/result_writer.h"
+#include "../include/all_pairs.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
 #include <assert.h>
 
+Graph* create_random_graph(int num_vertices, int num_edges, int max_weight,
+                           unsigned int seed) {
+    Graph* graph = create_graph(num_vertices);
+    srand(seed);
+
+    for (int i = 0; i < num_vertices - 1; i++) {
+        add_edge(graph, i, i + 1, 1 + rand() % max_weight);
+    }
+
+    for (int i = num_vertices - 1; i < num_edges; i++) {
+        add_edge(graph, rand() % num_vertices, rand() % num_vertices,
+                 1 + rand() % max_weight);
+    }
+
+    return graph;
+}
+
 void test_graph_creation() {
     printf("Testing graph creation...\n");
 
@@ -137,6 +167,809 @@ void test_single_target_dijkstra() {
     printf("Single target Dijkstra test passed!\n");
 }
 
+void test_dijkstra_options() {
+    printf("Testing Dijkstra options...\n");
+
+    Graph* graph = create_random_graph(120, 400, 10, 19);
+    add_edge(graph, 5, 60, 0);
+    DijkstraStats stats;
+
+    for (int source = 0; source < graph->num_vertices; source += 17) {
+        DijkstraResult expected = dijkstra(graph, source);
+
+        DijkstraOptions distances_only = {false, -1, NULL};
+        DijkstraResult result = dijkstra_with_options(graph, source, &distances_only);
+        assert(result.success == true);
+        assert(result.parents == NULL);
+        for (int v = 0; v < graph->num_vertices; v++) {
+            assert(result.distances[v] == expected.distances[v]);
+        }
+        free_dijkstra_result(result);
+
+        DijkstraOptions counted = {true, -1, &stats};
+        result = dijkstra_with_options(graph, source, &counted);
+        assert(result.success == true);
+
+        long long reachable = 0, edges = 0;
+        for (int v = 0; v < graph->num_vertices; v++) {
+            assert(result.distances[v] == expected.distances[v]);
+            assert(result.parents[v] == expected.parents[v]);
+            if (expected.distances[v] != INF) {
+                reachable++;
+                edges += graph->vertex_degrees[v];
+            }
+        }
+        assert(stats.vertices_settled == reachable);
+        assert(stats.edges_relaxed == edges);
+        assert(stats.decrease_keys >= reachable - 1);
+        free_dijkstra_result(result);
+
+        int target = (source + 50) % graph->num_vertices;
+        DijkstraOptions targeted = {true, target, &stats};
+        result = dijkstra_with_options(graph, source, &targeted);
+        assert(result.success == true);
+        assert(result.distances[target] == expected.distances[target]);
+        assert(stats.vertices_settled <= reachable);
+        free_dijkstra_result(result);
+
+        free_dijkstra_result(expected);
+    }
+
+    DijkstraOptions invalid_target = {true, 120, NULL};
+    DijkstraResult result = dijkstra_with_options(graph, 0, &invalid_target);
+    assert(result.success == false);
+    result = dijkstra_with_options(graph, 0, NULL);
+    assert(result.success == false);
+
+    destroy_graph(graph);
+    printf("Dijkstra options test passed!\n");
+}
+
+void test_one_to_many_dijkstra() {
+    printf("Testing one-to-many Dijkstra...\n");
+
+    Graph* graph = create_graph(6);
+    add_edge(graph, 0, 1, 2);
+    add_edge(graph, 0, 2, 4);
+    add_edge(graph, 1, 3, 3);
+    add_edge(graph, 2, 3, 1);
+    add_edge(graph, 3, 4, 2);
+
+    int targets[] = {4, 1, 5, 1, 0};
+    OneToManyResult result = dijkstra_one_to_many(graph, 0, targets, 5);
+    assert(result.success == true);
+    assert(result.num_targets == 5);
+    assert(result.distances[0] == 7);
+    assert(result.distances[1] == 2);
+    assert(result.distances[2] == INF);
+    assert(result.distances[3] == 2);
+    assert(result.distances[4] == 0);
+
+    free_one_to_many_result(result);
+
+    result = dijkstra_one_to_many(graph, 0, targets, 0);
+    assert(result.success == false);
+
+    destroy_graph(graph);
+    printf("One-to-many Dijkstra test passed!\n");
+}
+
+void test_crp_queries() {
+    printf("Testing CRP partition, customization and queries...\n");
+
+    Graph* graph = create_random_graph(200, 600, 20, 42);
+    int cell_sizes[] = {8, 32, 96};
+
+    CRPPartition* partition = crp_create_partition(graph, 3, cell_sizes);
+    assert(partition != NULL);
+    CRPOverlay* overlay = crp_create_overlay(partition);
+    assert(overlay != NULL);
+
+    for (int round = 0; round < 2; round++) {
+        assert(crp_customize(overlay, graph, 4) == true);
+        assert(crp_overlay_is_current(overlay, graph) == true);
+
+        for (int source = 0; source < graph->num_vertices; source += 13) {
+            DijkstraResult expected = dijkstra(graph, source);
+            for (int target = 0; target < graph->num_vertices; target++) {
+                assert(crp_query(overlay, graph, source, target) ==
+                       expected.distances[target]);
+            }
+            free_dijkstra_result(expected);
+        }
+
+        for (int u = 0; u < graph->num_vertices; u++) {
+            for (Edge* edge = graph->adjacency_list[u]; edge; edge = edge->next) {
+                assert(set_edge_weight(graph, u, edge->destination,
+                                       1 + rand() % 50) == true);
+            }
+        }
+
+        assert(crp_overlay_is_current(overlay, graph) == false);
+        assert(crp_query(overlay, graph, 0, 1) == INF);
+    }
+
+    crp_destroy_overlay(overlay);
+    crp_destroy_partition(partition);
+    destroy_graph(graph);
+    printf("CRP test passed!\n");
+}
+
+void test_hub_labels() {
+    printf("Testing hub labeling distance oracle...\n");
+
+    Graph* graph = create_random_graph(150, 450, 20, 7);
+    HubLabelStats stats;
+
+    HubLabels* labels = build_hub_labels(graph, NULL, &stats);
+    assert(labels != NULL);
+    assert(stats.average_label_size > 0);
+    assert(stats.bytes_per_vertex > 0);
+
+    const char* filename = "hub_labels_test.bin";
+    assert(save_hub_labels(labels, filename) == true);
+    HubLabels* loaded = load_hub_labels(filename);
+    remove(filename);
+    assert(loaded != NULL);
+
+    for (int source = 0; source < graph->num_vertices; source++) {
+        DijkstraResult expected = dijkstra(graph, source);
+        for (int target = 0; target < graph->num_vertices; target++) {
+            assert(hub_label_query(labels, source, target) ==
+                   expected.distances[target]);
+            assert(hub_label_query(loaded, source, target) ==
+                   expected.distances[target]);
+        }
+        free_dijkstra_result(expected);
+    }
+
+    size_t plain_bytes = hub_labels_memory_usage(loaded);
+    assert(compress_hub_labels(loaded) == true);
+    assert(loaded->compressed == true);
+    assert(hub_labels_memory_usage(loaded) < plain_bytes);
+
+    assert(save_hub_labels(loaded, filename) == true);
+    HubLabels* reloaded = load_hub_labels(filename);
+    remove(filename);
+    assert(reloaded != NULL);
+    assert(reloaded->compressed == false);
+
+    for (int source = 0; source < graph->num_vertices; source += 7) {
+        for (int target = 0; target < graph->num_vertices; target++) {
+            int expected = hub_label_query(labels, source, target);
+            assert(hub_label_query(loaded, source, target) == expected);
+            assert(hub_label_query(reloaded, source, target) == expected);
+        }
+    }
+
+    assert(expand_hub_labels(loaded) == true);
+    assert(loaded->compressed == false);
+    assert(hub_labels_memory_usage(loaded) == plain_bytes);
+    assert(hub_label_query(loaded, 3, 140) == hub_label_query(labels, 3, 140));
+    destroy_hub_labels(reloaded);
+
+    int order[150];
+    for (int i = 0; i < 150; i++) {
+        order[i] = 149 - i;
+    }
+    HubLabels* ordered = build_hub_labels(graph, order, NULL);
+    assert(ordered != NULL);
+    assert(hub_label_query(ordered, 0, 149) == hub_label_query(labels, 0, 149));
+
+    destroy_hub_labels(ordered);
+    destroy_hub_labels(loaded);
+    destroy_hub_labels(labels);
+    destroy_graph(graph);
+    printf("Hub labeling test passed!\n");
+}
+
+void test_compressed_graph() {
+    printf("Testing compressed adjacency storage...\n");
+
+    Graph* graph = create_random_graph(1000, 8000, 100000, 11);
+    add_edge(graph, 5, 5, 0);
+    add_edge(graph, 5, 999, 7);
+
+    CompressedGraph* compressed = compress_graph(graph);
+    assert(compressed != NULL);
+    assert(compressed->num_edges == 8002);
+    assert(compressed->weight_bits == 17);
+    assert(compressed_graph_memory_usage(compressed) * 3 <
+           graph_memory_usage(graph));
+
+    for (int source = 0; source < graph->num_vertices; source += 97) {
+        DijkstraResult expected = dijkstra(graph, source);
+        DijkstraResult result = dijkstra_compressed(compressed, source);
+        assert(result.success == true);
+        for (int v = 0; v < graph->num_vertices; v++) {
+            assert(result.distances[v] == expected.distances[v]);
+        }
+        free_dijkstra_result(result);
+        free_dijkstra_result(expected);
+    }
+
+    destroy_compressed_graph(compressed);
+    destroy_graph(graph);
+    printf("Compressed graph test passed!\n");
+}
+
+void test_allocation_policies() {
+    printf("Testing allocation policies...\n");
+
+    AllocPolicy policies[] = {
+        {PAGES_DEFAULT, NUMA_DEFAULT, 0},
+        {PAGES_TRANSPARENT_HUGE, NUMA_DEFAULT, 0},
+        {PAGES_EXPLICIT_HUGE, NUMA_INTERLEAVE, 0},
+        {PAGES_DEFAULT, NUMA_BIND, 0},
+    };
+
+    assert(numa_node_count() >= 1);
+
+    for (int p = 0; p < 4; p++) {
+        size_t count = 1 << 20;
+        int* buffer = policy_alloc_with(count * sizeof(int), policies[p]);
+        assert(buffer != NULL);
+        for (size_t i = 0; i < count; i++) {
+            buffer[i] = (int)i;
+        }
+        assert(buffer[count - 1] == (int)(count - 1));
+        policy_free(buffer);
+
+        set_alloc_policy(policies[p]);
+        Graph* graph = create_random_graph(100, 400, 10, 3);
+        Graph* replica = replicate_graph(graph, 0);
+        assert(replica != NULL);
+        add_edge(replica, 0, 99, 1);
+        add_edge(graph, 0, 99, 1);
+
+        DijkstraResult expected = dijkstra(graph, 0);
+        DijkstraResult result = dijkstra(replica, 0);
+        for (int v = 0; v < 100; v++) {
+            assert(result.distances[v] == expected.distances[v]);
+            assert(result.parents[v] == expected.parents[v]);
+        }
+
+        free_dijkstra_result(result);
+        free_dijkstra_result(expected);
+        destroy_graph(replica);
+        destroy_graph(graph);
+    }
+
+    set_alloc_policy(policies[0]);
+    printf("Allocation policies test passed!\n");
+}
+
+void* snapshot_reader(void* arg) {
+    VersionedGraph* versioned = arg;
+    int reader = register_reader(versioned);
+    assert(reader >= 0);
+
+    for (int i = 0; i < 2000; i++) {
+        Graph* snapshot = acquire_snapshot(versioned, reader);
+
+        int count = 0;
+        for (Edge* edge = snapshot->adjacency_list[0]; edge; edge = edge->next) {
+            count++;
+        }
+        assert(count == snapshot->vertex_degrees[0]);
+        assert(count == snapshot->vertex_degrees[1] + 1);
+
+        release_snapshot(versioned, reader);
+    }
+
+    unregister_reader(versioned, reader);
+    return NULL;
+}
+
+void test_versioned_graph() {
+    printf("Testing versioned graph snapshots...\n");
+
+    VersionedGraph* versioned = create_versioned_graph(create_graph(4));
+    assert(versioned != NULL);
+    assert(current_version(versioned) == 1);
+
+    int reader = register_reader(versioned);
+    Graph* pinned = acquire_snapshot(versioned, reader);
+
+    Graph* next = begin_update(versioned);
+    add_edge(next, 0, 1, 5);
+    assert(publish_update(versioned, next) == true);
+    assert(current_version(versioned) == 2);
+
+    assert(pinned->vertex_degrees[0] == 0);
+    assert(reclaim_versions(versioned) == 1);
+    release_snapshot(versioned, reader);
+    assert(reclaim_versions(versioned) == 0);
+
+    Graph* snapshot = acquire_snapshot(versioned, reader);
+    DijkstraResult result = dijkstra(snapshot, 0);
+    assert(result.distances[1] == 5);
+    free_dijkstra_result(result);
+    release_snapshot(versioned, reader);
+    unregister_reader(versioned, reader);
+
+    pthread_t threads[3];
+    for (int t = 0; t < 3; t++) {
+        pthread_create(&threads[t], NULL, snapshot_reader, versioned);
+    }
+
+    for (int i = 0; i < 200; i++) {
+        next = begin_update(versioned);
+        add_edge(next, 0, 2, i);
+        add_edge(next, 1, 3, i);
+        assert(publish_update(versioned, next) == true);
+    }
+
+    for (int t = 0; t < 3; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    assert(current_version(versioned) == 202);
+    assert(reclaim_versions(versioned) == 0);
+
+    destroy_versioned_graph(versioned);
+    printf("Versioned graph test passed!\n");
+}
+
+DijkstraResult run_profiled_dijkstra(void* context, int source,
+                                     DijkstraStats* stats) {
+    (void)stats;
+    return dijkstra(context, source);
+}
+
+DijkstraResult run_profiled_single_target(void* context, int source,
+                                          DijkstraStats* stats) {
+    DijkstraOptions options = {true, 1, stats};
+    return dijkstra_with_options(context, source, &options);
+}
+
+void test_perf_counters() {
+    printf("Testing performance counter harness...\n");
+
+    Graph* graph = create_graph(4);
+    add_edge(graph, 0, 1, 1);
+    add_edge(graph, 0, 2, 1);
+    add_edge(graph, 1, 2, 1);
+    add_edge(graph, 3, 0, 1);
+
+    PerfCounters counters;
+    PerfReport report;
+    int sources[] = {0, 1, 3};
+
+    perf_counters_open(&counters);
+    assert(profile_engine(&counters, run_profiled_dijkstra, graph, graph,
+                          sources, 3, &report) == true);
+    assert(report.queries == 3);
+    assert(report.edges_relaxed == 3 + 1 + 4);
+    assert(report.elapsed_ms >= 0);
+
+    /* From 0 the search stops on extracting 1, having scanned only the
+     * edges of 0; vertex 1 was reached but its edge never relaxed. */
+    assert(profile_engine(&counters, run_profiled_single_target, graph, graph,
+                          sources, 1, &report) == true);
+    assert(report.edges_relaxed == 2);
+
+    /* An opened event can still report nothing if its group was never
+     * scheduled, but an event that failed to open is never valid. */
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        assert(counters.fds[e] >= 0 || !report.totals.valid[e]);
+    }
+
+    perf_counters_close(&counters);
+    destroy_graph(graph);
+    printf("Performance counter harness test passed!\n");
+}
+
+void test_batched_dijkstra() {
+    printf("Testing batched Dijkstra...\n");
+
+    Graph* graph = create_random_graph(150, 500, 30, 11);
+    add_edge(graph, 149, 0, 5);
+    Graph* isolated = create_graph(3);
+    add_edge(isolated, 0, 1, 4);
+
+    int sources[] = {0, 17, 17, 42, 99, 149, 3, 120, 64, 8, 77};
+    int num_sources = sizeof(sources) / sizeof(sources[0]);
+
+    BatchResult batch = dijkstra_batch(graph, sources, num_sources);
+    assert(batch.success == true);
+    assert(batch.num_sources == num_sources);
+
+    for (int i = 0; i < num_sources; i++) {
+        DijkstraResult expected = dijkstra(graph, sources[i]);
+        for (int v = 0; v < graph->num_vertices; v++) {
+            assert(batch_distance(batch, i, v) == expected.distances[v]);
+        }
+        free_dijkstra_result(expected);
+    }
+    free_batch_result(batch);
+
+    int isolated_sources[] = {1, 0};
+    batch = dijkstra_batch(isolated, isolated_sources, 2);
+    assert(batch.success == true);
+    assert(batch_distance(batch, 0, 0) == INF);
+    assert(batch_distance(batch, 0, 1) == 0);
+    assert(batch_distance(batch, 1, 1) == 4);
+    assert(batch_distance(batch, 1, 2) == INF);
+    free_batch_result(batch);
+
+    int invalid_sources[] = {0, 5};
+    batch = dijkstra_batch(isolated, invalid_sources, 2);
+    assert(batch.success == false);
+
+    destroy_graph(isolated);
+    destroy_graph(graph);
+    printf("Batched Dijkstra test passed!\n");
+}
+
+void test_graph_reduction() {
+    printf("Testing graph reduction...\n");
+
+    /* Vertices 0 and 1 joined by an edge and two chains (0-2-1 once the
+     * tree 6-7 / 6-8 is pruned, and 0-3-4-5-1 with 5 -> 4 one-way), plus
+     * a cycle 9-10-11 of degree-2 vertices with a zero-weight link. */
+    Graph* graph = create_graph(12);
+    add_edge(graph, 0, 1, 10);
+    add_edge(graph, 1, 2, 3);
+    add_edge(graph, 2, 0, 4);
+    add_edge(graph, 0, 3, 1);
+    add_edge(graph, 3, 0, 1);
+    add_edge(graph, 3, 4, 2);
+    add_edge(graph, 4, 3, 2);
+    add_edge(graph, 4, 5, 2);
+    add_edge(graph, 5, 4, 7);
+    add_edge(graph, 5, 1, 1);
+    add_edge(graph, 1, 5, 1);
+    add_edge(graph, 2, 6, 5);
+    add_edge(graph, 6, 7, 1);
+    add_edge(graph, 8, 6, 1);
+    add_edge(graph, 9, 10, 0);
+    add_edge(graph, 10, 9, 0);
+    add_edge(graph, 10, 11, 2);
+    add_edge(graph, 11, 9, 3);
+
+    ReducedGraph* reduced = reduce_graph(graph);
+    assert(reduced != NULL);
+    assert(reduced->num_pruned == 3);
+    assert(reduced->num_core == 3);
+    assert(reduced->num_chains == 3);
+
+    Graph* random_graph = create_random_graph(300, 320, 9, 5);
+    for (int v = 1; v < 300; v += 4) {
+        add_edge(random_graph, v + 1 < 300 ? v + 1 : 0, v, 0);
+    }
+    ReducedGraph* random_reduced = reduce_graph(random_graph);
+    assert(random_reduced != NULL);
+    assert(random_reduced->num_core < 300);
+
+    Graph* graphs[] = {graph, random_graph};
+    ReducedGraph* reductions[] = {reduced, random_reduced};
+
+    for (int g = 0; g < 2; g++) {
+        int n = graphs[g]->num_vertices;
+
+        for (int source = 0; source < n; source++) {
+            DijkstraResult expected = dijkstra(graphs[g], source);
+            DijkstraResult actual = dijkstra_reduced(reductions[g], source);
+            assert(actual.success == true);
+
+            for (int v = 0; v < n; v++) {
+                assert(actual.distances[v] == expected.distances[v]);
+                if (v == source || actual.distances[v] == INF) continue;
+
+                int parent = actual.parents[v];
+                bool tight = false;
+                for (Edge* e = graphs[g]->adjacency_list[parent]; e; e = e->next) {
+                    if (e->destination == v &&
+                        actual.distances[parent] + e->weight == actual.distances[v]) {
+                        tight = true;
+                    }
+                }
+                assert(tight);
+
+                int steps = 0;
+                for (int u = v; u != source; u = actual.parents[u]) {
+                    assert(++steps < n);
+                }
+            }
+
+            free_dijkstra_result(expected);
+            free_dijkstra_result(actual);
+        }
+    }
+
+    assert(dijkstra_reduced(reduced, 12).success == false);
+
+    destroy_reduced_graph(random_reduced);
+    destroy_reduced_graph(reduced);
+    destroy_graph(random_graph);
+    destroy_graph(graph);
+    printf("Graph reduction test passed!\n");
+}
+
+void test_interleaved_dijkstra() {
+    printf("Testing interleaved Dijkstra...\n");
+
+    Graph* graph = create_random_graph(200, 700, 5, 23);
+    Graph* disconnected = create_graph(6);
+    add_edge(disconnected, 0, 1, 2);
+    add_edge(disconnected, 1, 2, 2);
+    add_edge(disconnected, 4, 5, 1);
+
+    int sources[] = {0, 5, 5, 199, 73, 120, 1, 64, 150, 31, 99, 7, 180};
+    int num_sources = sizeof(sources) / sizeof(sources[0]);
+    int widths[] = {1, 4, 0, 32};
+    DijkstraResult results[13];
+
+    for (int w = 0; w < 4; w++) {
+        assert(dijkstra_interleaved(graph, sources, num_sources, widths[w],
+                                    results) == true);
+
+        for (int i = 0; i < num_sources; i++) {
+            DijkstraResult expected = dijkstra(graph, sources[i]);
+            assert(results[i].success == true);
+            for (int v = 0; v < graph->num_vertices; v++) {
+                assert(results[i].distances[v] == expected.distances[v]);
+                assert(results[i].parents[v] == expected.parents[v]);
+            }
+            free_dijkstra_result(expected);
+            free_dijkstra_result(results[i]);
+        }
+    }
+
+    int small_sources[] = {0, 4, 3};
+    assert(dijkstra_interleaved(disconnected, small_sources, 3, 2, results) == true);
+    assert(results[0].distances[2] == 4);
+    assert(results[0].distances[4] == INF);
+    assert(results[1].distances[5] == 1);
+    assert(results[1].parents[5] == 4);
+    assert(results[2].distances[3] == 0);
+    assert(results[2].distances[0] == INF);
+    for (int i = 0; i < 3; i++) {
+        free_dijkstra_result(results[i]);
+    }
+
+    int invalid_sources[] = {0, 6};
+    assert(dijkstra_interleaved(disconnected, invalid_sources, 2, 2, results) == false);
+
+    destroy_graph(disconnected);
+    destroy_graph(graph);
+    printf("Interleaved Dijkstra test passed!\n");
+}
+
+char* read_stream(FILE* stream) {
+    long size = ftell(stream);
+    char* contents = malloc(size + 1);
+
+    rewind(stream);
+    assert(fread(contents, 1, size, stream) == (size_t)size);
+    contents[size] = '\0';
+    return contents;
+}
+
+void test_result_writer() {
+    printf("Testing result writer...\n");
+
+    char digits[12];
+    int values[] = {0, 7, 10, 99, 100, -5, 999999, INT_MAX, INT_MIN};
+    const char* expected_digits[] = {"0", "7", "10", "99", "100", "-5", "999999",
+                                     "2147483647", "-2147483648"};
+    for (int i = 0; i < 9; i++) {
+        int length = format_int(digits, values[i]);
+        assert(length == (int)strlen(expected_digits[i]));
+        assert(memcmp(digits, expected_digits[i], length) == 0);
+    }
+
+    Graph* graph = create_graph(7);
+    add_edge(graph, 0, 1, 4);
+    add_edge(graph, 0, 2, 3);
+    add_edge(graph, 1, 2, 1);
+    add_edge(graph, 1, 3, 2);
+    add_edge(graph, 2, 3, 4);
+    add_edge(graph, 3, 4, 2);
+    add_edge(graph, 4, 5, 6);
+    add_edge(graph, 2, 5, 5);
+    DijkstraResult result = dijkstra(graph, 0);
+
+    const char* expected_text =
+        "Path from 0 to 1 (distance: 4): 0 -> 1\n"
+        "Path from 0 to 3 (distance: 6): 0 -> 1 -> 3\n"
+        "Path from 0 to 4 (distance: 8): 0 -> 1 -> 3 -> 4\n"
+        "Path from 0 to 2 (distance: 3): 0 -> 2\n"
+        "Path from 0 to 5 (distance: 8): 0 -> 2 -> 5\n"
+        "No path from 0 to 6\n";
+
+    size_t capacities[] = {0, 8};
+    for (int c = 0; c < 2; c++) {
+        FILE* stream = tmpfile();
+        ResultWriter* writer = create_result_writer(stream, capacities[c]);
+        assert(write_result_tree(writer, result, 7, 0, RESULT_TEXT) == true);
+        assert(destroy_result_writer(writer) == true);
+
+        char* contents = read_stream(stream);
+        assert(strcmp(contents, expected_text) == 0);
+        free(contents);
+        fclose(stream);
+    }
+
+    FILE* stream = tmpfile();
+    ResultWriter* writer = create_result_writer(stream, 0);
+    assert(write_result_tree(writer, result, 7, 0, RESULT_JSON_LINES) == true);
+    assert(destroy_result_writer(writer) == true);
+    char* contents = read_stream(stream);
+    const char* expected_json =
+        "{\"source\":0,\"vertex\":0,\"distance\":0,\"parent\":-1}\n"
+        "{\"source\":0,\"vertex\":1,\"distance\":4,\"parent\":0}\n";
+    assert(strncmp(contents, expected_json, strlen(expected_json)) == 0);
+    assert(strstr(contents, "{\"source\":0,\"vertex\":6,\"distance\":null,\"parent\":-1}\n"));
+    free(contents);
+    fclose(stream);
+
+    stream = tmpfile();
+    writer = create_result_writer(stream, 16);
+    assert(write_result_tree(writer, result, 7, 0, RESULT_BINARY) == true);
+    assert(destroy_result_writer(writer) == true);
+    rewind(stream);
+    int num_vertices, source;
+    DijkstraResult loaded = read_result_binary(stream, &num_vertices, &source);
+    assert(loaded.success == true);
+    assert(num_vertices == 7 && source == 0);
+    for (int v = 0; v < 7; v++) {
+        assert(loaded.distances[v] == result.distances[v]);
+        assert(loaded.parents[v] == result.parents[v]);
+    }
+    free_dijkstra_result(loaded);
+    fclose(stream);
+
+    Graph* chain = create_graph(MAX_VERTICES);
+    for (int v = 0; v + 1 < MAX_VERTICES; v++) {
+        add_edge(chain, v, v + 1, 1);
+    }
+    DijkstraResult chain_result = dijkstra(chain, 0);
+
+    stream = tmpfile();
+    writer = create_result_writer(stream, 0);
+    assert(write_result_tree(writer, chain_result, MAX_VERTICES, 0, RESULT_TEXT) == true);
+    assert(destroy_result_writer(writer) == true);
+    contents = read_stream(stream);
+
+    int lines = 0;
+    for (char* p = contents; *p; p++) {
+        lines += *p == '\n';
+    }
+    assert(lines == MAX_VERTICES - 1);
+    assert(strstr(contents, "Path from 0 to 999 (distance: 999): 0 -> 1 -> 2 -> "));
+    assert(strcmp(contents + strlen(contents) - 18, "997 -> 998 -> 999\n") == 0);
+    free(contents);
+    fclose(stream);
+
+    free_dijkstra_result(chain_result);
+    free_dijkstra_result(result);
+    destroy_graph(chain);
+    destroy_graph(graph);
+    printf("Result writer test passed!\n");
+}
+
+void check_all_pairs_table(Graph* graph, const AllPairsTable* table) {
+    int n = graph->num_vertices;
+    int* path = malloc(n * sizeof(int));
+
+    for (int source = 0; source < n; source++) {
+        DijkstraResult expected = dijkstra(graph, source);
+
+        for (int target = 0; target < n; target++) {
+            int distance = all_pairs_distance(table, source, target);
+            assert(distance == expected.distances[target]);
+
+            int length = all_pairs_path(table, source, target, path, n);
+            if (distance == INF) {
+                assert(length == -1);
+                continue;
+            }
+
+            assert(length >= 1);
+            assert(path[0] == source && path[length - 1] == target);
+
+            int total = 0;
+            for (int i = 0; i + 1 < length; i++) {
+                int best = INF;
+                for (Edge* edge = graph->adjacency_list[path[i]]; edge;
+                     edge = edge->next) {
+                    if (edge->destination == path[i + 1] && edge->weight < best) {
+                        best = edge->weight;
+                    }
+                }
+                assert(best != INF);
+                total += best;
+            }
+            assert(total == distance);
+        }
+        free_dijkstra_result(expected);
+    }
+
+    free(path);
+}
+
+void test_all_pairs() {
+    printf("Testing all-pairs distance table...\n");
+
+    Graph* graph = create_random_graph(70, 260, 9, 41);
+    add_edge(graph, 12, 40, 0);
+    AllPairsMethod methods[] = {ALL_PAIRS_FLOYD_WARSHALL, ALL_PAIRS_DIJKSTRA};
+    int path[70];
+
+    for (int m = 0; m < 2; m++) {
+        AllPairsTable* table = build_all_pairs(graph, methods[m], true, 4);
+        assert(table != NULL);
+        assert(table->method == methods[m]);
+        assert(table->stride % ALL_PAIRS_BLOCK == 0);
+        check_all_pairs_table(graph, table);
+        destroy_all_pairs(table);
+    }
+
+    /* Zero-weight cycles leave ties among equally short paths; every
+     * recovered path must still reach its target. */
+    for (unsigned int seed = 0; seed < 10; seed++) {
+        Graph* zero = create_graph(117);
+        srand(seed);
+        for (int i = 0; i < 350; i++) {
+            add_edge(zero, rand() % 117, rand() % 117, rand() % 3);
+        }
+        add_edge(zero, 21, 68, 0);
+        add_edge(zero, 68, 26, 0);
+        add_edge(zero, 26, 92, 0);
+        add_edge(zero, 92, 21, 0);
+
+        for (int m = 0; m < 2; m++) {
+            AllPairsTable* table = build_all_pairs(zero, methods[m], true, 2);
+            assert(table != NULL);
+            check_all_pairs_table(zero, table);
+            destroy_all_pairs(table);
+        }
+        destroy_graph(zero);
+    }
+
+    AllPairsTable* table = build_all_pairs(graph, ALL_PAIRS_AUTO, false, 0);
+    assert(table != NULL);
+    assert(table->method == choose_all_pairs_method(graph));
+    assert(table->predecessors == NULL);
+    assert(all_pairs_path(table, 0, 1, path, 70) == -1);
+    assert(all_pairs_distance(table, 0, 70) == INF);
+    assert(all_pairs_distance(table, -1, 0) == INF);
+
+    AllPairsTable* with_paths = build_all_pairs(graph, ALL_PAIRS_DIJKSTRA, true, 2);
+    const char* filename = "all_pairs_test.bin";
+    assert(save_all_pairs(with_paths, filename) == true);
+    AllPairsTable* loaded = load_all_pairs(filename);
+    remove(filename);
+    assert(loaded != NULL);
+    assert(loaded->num_vertices == 70 && loaded->predecessors != NULL);
+    for (int source = 0; source < 70; source++) {
+        for (int target = 0; target < 70; target++) {
+            assert(all_pairs_distance(loaded, source, target) ==
+                   all_pairs_distance(table, source, target));
+            assert(all_pairs_path(loaded, source, target, path, 70) ==
+                   all_pairs_path(with_paths, source, target, path, 70));
+        }
+    }
+    assert(all_pairs_path(loaded, 0, 69, path, 2) == -1);
+
+    Graph* dense = create_graph(8);
+    for (int u = 0; u < 8; u++) {
+        for (int v = 0; v < 8; v++) {
+            if (u != v) add_edge(dense, u, v, 1 + (u * 3 + v) % 5);
+        }
+    }
+    assert(choose_all_pairs_method(dense) == ALL_PAIRS_FLOYD_WARSHALL);
+
+    destroy_graph(dense);
+    destroy_all_pairs(loaded);
+    destroy_all_pairs(with_paths);
+    destroy_all_pairs(table);
+    destroy_graph(graph);
+    printf("All-pairs table test passed!\n");
+}
+
 void test_large_graph() {
     printf("Testing large graph performance...\n");
 
@@ -184,6 +1017,19 @@ int main() {
     test_simple_dijkstra();
     test_disconnected_graph();
     test_single_target_dijkstra();
+    test_dijkstra_options();
+    test_one_to_many_dijkstra();
+    test_crp_queries();
+    test_hub_labels();
+    test_compressed_graph();
+    test_allocation_policies();
+    test_versioned_graph();
+    test_perf_counters();
+    test_batched_dijkstra();
+    test_graph_reduction();
+    test_interleaved_dijkstra();
+    test_result_writer();
+    test_all_pairs();
     test_large_graph();
     test_edge_cases();
 
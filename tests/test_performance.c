@@ -0,0 +1,563 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/allocator.h"
+#include "../include/versioned_graph.h"
+#include "../include/compressed_graph.h"
+#include "../include/perf_counters.h"
+#include "../include/dijkstra_batch.h"
+#include "../include/reduction.h"
+#include "../include/dijkstra_interleaved.h"
+#include "../include/result_writer.h"
+#include "../include/all_pairs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_VERTICES 1000
+#define BENCH_DEGREE 500
+#define BENCH_QUERIES 200
+#define BENCH_PINS 1000000
+#define BENCH_UPDATES 50
+#define BENCH_READERS 3
+#define BENCH_GRID 12
+#define BENCH_EXPORT_VERTICES 1000000
+#define BENCH_THREADS 4
+
+typedef struct SnapshotReader {
+    VersionedGraph* versioned;
+    volatile int* stop;
+    long queries;
+} SnapshotReader;
+
+typedef struct NamedPolicy {
+    const char* name;
+    AllocPolicy policy;
+} NamedPolicy;
+
+double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+Graph* create_benchmark_graph(int num_vertices, int degree, unsigned int seed) {
+    Graph* graph = create_graph(num_vertices);
+    if (!graph) {
+        return NULL;
+    }
+
+    srand(seed);
+    for (int u = 0; u < num_vertices; u++) {
+        for (int i = 0; i < degree; i++) {
+            add_edge(graph, u, rand() % num_vertices, 1 + rand() % 1000);
+        }
+    }
+
+    return graph;
+}
+
+double time_queries(Graph* graph, int num_queries) {
+    double start = now_ms();
+
+    for (int i = 0; i < num_queries; i++) {
+        DijkstraResult result = dijkstra(graph, i % graph->num_vertices);
+        free_dijkstra_result(result);
+    }
+
+    return now_ms() - start;
+}
+
+void bench_allocation_policies() {
+    NamedPolicy policies[] = {
+        {"malloc", {PAGES_DEFAULT, NUMA_DEFAULT, 0}},
+        {"transparent huge pages", {PAGES_TRANSPARENT_HUGE, NUMA_DEFAULT, 0}},
+        {"explicit huge pages", {PAGES_EXPLICIT_HUGE, NUMA_DEFAULT, 0}},
+        {"node-local", {PAGES_DEFAULT, NUMA_LOCAL, 0}},
+        {"interleaved + THP", {PAGES_TRANSPARENT_HUGE, NUMA_INTERLEAVE, 0}},
+    };
+    int num_policies = sizeof(policies) / sizeof(policies[0]);
+
+    printf("\n=== Allocation policies (%d vertices, %d edges, %d NUMA nodes) ===\n",
+           BENCH_VERTICES, BENCH_VERTICES * BENCH_DEGREE, numa_node_count());
+    printf("%-28s %12s %14s\n", "Policy", "Build (ms)", "Queries (ms)");
+
+    for (int p = 0; p < num_policies; p++) {
+        set_alloc_policy(policies[p].policy);
+
+        double start = now_ms();
+        Graph* graph = create_benchmark_graph(BENCH_VERTICES, BENCH_DEGREE, 1);
+        double build = now_ms() - start;
+
+        printf("%-28s %12.1f %14.1f\n", policies[p].name, build,
+               time_queries(graph, BENCH_QUERIES));
+        destroy_graph(graph);
+    }
+
+    set_alloc_policy(policies[0].policy);
+    Graph* graph = create_benchmark_graph(BENCH_VERTICES, BENCH_DEGREE, 1);
+
+    for (int node = 0; node < numa_node_count(); node++) {
+        double start = now_ms();
+        Graph* replica = replicate_graph(graph, node);
+        double build = now_ms() - start;
+        bool pinned = pin_thread_to_node(node);
+
+        printf("replica on node %-2d%-10s %12.1f %14.1f\n", node,
+               pinned ? " (pinned)" : "", build,
+               time_queries(replica, BENCH_QUERIES));
+        destroy_graph(replica);
+    }
+
+    destroy_graph(graph);
+}
+
+void* run_snapshot_reader(void* arg) {
+    SnapshotReader* reader = arg;
+    int slot = register_reader(reader->versioned);
+
+    while (!*reader->stop) {
+        Graph* graph = acquire_snapshot(reader->versioned, slot);
+        DijkstraResult result = dijkstra_single_target(
+            graph, reader->queries % graph->num_vertices, graph->num_vertices - 1);
+        free_dijkstra_result(result);
+        release_snapshot(reader->versioned, slot);
+        reader->queries++;
+    }
+
+    unregister_reader(reader->versioned, slot);
+    return NULL;
+}
+
+void bench_snapshot_updates() {
+    Graph* graph = create_benchmark_graph(BENCH_VERTICES, BENCH_DEGREE / 10, 2);
+    VersionedGraph* versioned = create_versioned_graph(graph);
+
+    printf("\n=== Snapshot updates (%d vertices, %d edges) ===\n",
+           BENCH_VERTICES, BENCH_VERTICES * BENCH_DEGREE / 10);
+
+    int slot = register_reader(versioned);
+    double start = now_ms();
+    for (int i = 0; i < BENCH_PINS; i++) {
+        acquire_snapshot(versioned, slot);
+        release_snapshot(versioned, slot);
+    }
+    printf("Reader pin + release:          %10.1f ns\n",
+           (now_ms() - start) * 1000000.0 / BENCH_PINS);
+
+    start = now_ms();
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        DijkstraResult result = dijkstra(graph, i % BENCH_VERTICES);
+        free_dijkstra_result(result);
+    }
+    double direct = now_ms() - start;
+
+    start = now_ms();
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        Graph* snapshot = acquire_snapshot(versioned, slot);
+        DijkstraResult result = dijkstra(snapshot, i % BENCH_VERTICES);
+        free_dijkstra_result(result);
+        release_snapshot(versioned, slot);
+    }
+    double pinned = now_ms() - start;
+    unregister_reader(versioned, slot);
+
+    printf("Query, direct vs snapshot:     %10.3f ms vs %.3f ms\n",
+           direct / BENCH_QUERIES, pinned / BENCH_QUERIES);
+
+    volatile int stop = 0;
+    pthread_t threads[BENCH_READERS];
+    SnapshotReader readers[BENCH_READERS];
+    for (int t = 0; t < BENCH_READERS; t++) {
+        readers[t].versioned = versioned;
+        readers[t].stop = &stop;
+        readers[t].queries = 0;
+        pthread_create(&threads[t], NULL, run_snapshot_reader, &readers[t]);
+    }
+
+    double build = 0, publish = 0;
+    double window = now_ms();
+    for (int i = 0; i < BENCH_UPDATES; i++) {
+        start = now_ms();
+        Graph* next = begin_update(versioned);
+        add_edge(next, i % BENCH_VERTICES, (i * 7) % BENCH_VERTICES, 1 + i);
+        double built = now_ms();
+        publish_update(versioned, next);
+        build += built - start;
+        publish += now_ms() - built;
+    }
+    window = now_ms() - window;
+
+    stop = 1;
+    long queries = 0;
+    for (int t = 0; t < BENCH_READERS; t++) {
+        pthread_join(threads[t], NULL);
+        queries += readers[t].queries;
+    }
+
+    printf("Update copy + apply:           %10.3f ms\n", build / BENCH_UPDATES);
+    printf("Update publish:                %10.3f ms\n", publish / BENCH_UPDATES);
+    printf("Reader queries during updates: %10.0f /s (%d readers)\n",
+           queries * 1000.0 / window, BENCH_READERS);
+
+    destroy_versioned_graph(versioned);
+}
+
+DijkstraResult run_dijkstra(void* context, int source, DijkstraStats* stats) {
+    (void)stats;
+    return dijkstra(context, source);
+}
+
+DijkstraResult run_single_target(void* context, int source, DijkstraStats* stats) {
+    Graph* graph = context;
+    DijkstraOptions options = {true, graph->num_vertices - 1, stats};
+    return dijkstra_with_options(graph, source, &options);
+}
+
+DijkstraResult run_compressed(void* context, int source, DijkstraStats* stats) {
+    (void)stats;
+    return dijkstra_compressed(context, source);
+}
+
+void bench_hardware_counters() {
+    Graph* graph = create_benchmark_graph(BENCH_VERTICES, BENCH_DEGREE / 10, 3);
+    CompressedGraph* compressed = compress_graph(graph);
+    PerfCounters counters;
+    PerfReport report;
+    int sources[BENCH_QUERIES / 4];
+
+    for (int i = 0; i < BENCH_QUERIES / 4; i++) {
+        sources[i] = (i * 37) % BENCH_VERTICES;
+    }
+
+    printf("\n=== Hardware counters (%d vertices, %d edges) ===\n",
+           BENCH_VERTICES, BENCH_VERTICES * BENCH_DEGREE / 10);
+
+    if (!perf_counters_open(&counters)) {
+        printf("perf_event_open unavailable (check kernel.perf_event_paranoid); "
+               "reporting timings only\n");
+    }
+
+    if (profile_engine(&counters, run_dijkstra, graph, graph, sources,
+                       BENCH_QUERIES / 4, &report)) {
+        print_perf_report("dijkstra", &report);
+    }
+    if (profile_engine(&counters, run_single_target, graph, graph, sources,
+                       BENCH_QUERIES / 4, &report)) {
+        print_perf_report("dijkstra_single_target", &report);
+    }
+    if (profile_engine(&counters, run_compressed, compressed, graph, sources,
+                       BENCH_QUERIES / 4, &report)) {
+        print_perf_report("dijkstra_compressed", &report);
+    }
+
+    perf_counters_close(&counters);
+    destroy_compressed_graph(compressed);
+    destroy_graph(graph);
+}
+
+void bench_batched_sources() {
+    Graph* graph = create_benchmark_graph(BENCH_VERTICES, BENCH_DEGREE / 10, 4);
+    int sources[BENCH_QUERIES];
+
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        sources[i] = (i * 37) % BENCH_VERTICES;
+    }
+
+    printf("\n=== Batched sources (%d vertices, %d edges, %d lanes) ===\n",
+           BENCH_VERTICES, BENCH_VERTICES * BENCH_DEGREE / 10, BATCH_LANES);
+
+    double start = now_ms();
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        DijkstraResult result = dijkstra(graph, sources[i]);
+        free_dijkstra_result(result);
+    }
+    double single = now_ms() - start;
+
+    start = now_ms();
+    BatchResult batch = dijkstra_batch(graph, sources, BENCH_QUERIES);
+    double batched = now_ms() - start;
+    free_batch_result(batch);
+
+    printf("dijkstra per source:           %10.3f ms\n", single / BENCH_QUERIES);
+    printf("dijkstra_batch per source:     %10.3f ms\n", batched / BENCH_QUERIES);
+
+    destroy_graph(graph);
+}
+
+/* Grid of intersections whose roads are split into two-vertex chains,
+ * with short dead-end branches hanging off random vertices. */
+Graph* create_road_graph(int grid, int branches, unsigned int seed) {
+    int intersections = grid * grid;
+    int roads = 2 * grid * (grid - 1);
+    Graph* graph = create_graph(intersections + 2 * roads + branches);
+    if (!graph) {
+        return NULL;
+    }
+
+    srand(seed);
+    int next = intersections;
+    for (int u = 0; u < intersections; u++) {
+        int neighbors[2] = {u % grid + 1 < grid ? u + 1 : -1,
+                            u + grid < intersections ? u + grid : -1};
+
+        for (int k = 0; k < 2; k++) {
+            if (neighbors[k] < 0) continue;
+
+            int path[4] = {u, next, next + 1, neighbors[k]};
+            for (int i = 0; i < 3; i++) {
+                int weight = 1 + rand() % 100;
+                add_edge(graph, path[i], path[i + 1], weight);
+                add_edge(graph, path[i + 1], path[i], weight);
+            }
+            next += 2;
+        }
+    }
+
+    for (int i = 0; i < branches; i++) {
+        int weight = 1 + rand() % 100;
+        int root = rand() % next;
+        add_edge(graph, root, next, weight);
+        add_edge(graph, next, root, weight);
+        next++;
+    }
+
+    return graph;
+}
+
+void bench_graph_reduction() {
+    int branches = 150;
+    Graph* graph = create_road_graph(BENCH_GRID, branches, 5);
+    int num_vertices = graph->num_vertices;
+
+    double start = now_ms();
+    ReducedGraph* reduced = reduce_graph(graph);
+    double build = now_ms() - start;
+
+    printf("\n=== Graph reduction (%d-vertex road grid) ===\n", num_vertices);
+    printf("Core vertices:                 %10d (%.0f%% removed)\n",
+           reduced->num_core,
+           100.0 * (num_vertices - reduced->num_core) / num_vertices);
+    printf("Chains / pruned vertices:      %6d / %d\n",
+           reduced->num_chains, reduced->num_pruned);
+    printf("Preprocessing:                 %10.3f ms\n", build);
+
+    start = now_ms();
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        DijkstraResult result = dijkstra(graph, (i * 37) % num_vertices);
+        free_dijkstra_result(result);
+    }
+    double original = now_ms() - start;
+
+    start = now_ms();
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        DijkstraResult result = dijkstra_reduced(reduced, (i * 37) % num_vertices);
+        free_dijkstra_result(result);
+    }
+    double contracted = now_ms() - start;
+
+    printf("dijkstra per query:            %10.3f ms\n", original / BENCH_QUERIES);
+    printf("dijkstra_reduced per query:    %10.3f ms\n", contracted / BENCH_QUERIES);
+
+    destroy_reduced_graph(reduced);
+    destroy_graph(graph);
+}
+
+void bench_interleaved_queries() {
+    /* Edges inserted in random source order, so each adjacency list is
+     * scattered across the heap as in a graph loaded from an edge file. */
+    Graph* graph = create_graph(BENCH_VERTICES);
+    srand(6);
+    for (int i = 0; i < BENCH_VERTICES * BENCH_DEGREE / 10; i++) {
+        add_edge(graph, rand() % BENCH_VERTICES, rand() % BENCH_VERTICES,
+                 1 + rand() % 1000);
+    }
+
+    int sources[BENCH_QUERIES];
+    DijkstraResult results[BENCH_QUERIES];
+    int widths[] = {1, 2, 4, 8, 16};
+
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        sources[i] = (i * 37) % BENCH_VERTICES;
+    }
+
+    printf("\n=== Interleaved queries (%d vertices, %d edges) ===\n",
+           BENCH_VERTICES, BENCH_VERTICES * BENCH_DEGREE / 10);
+
+    double start = now_ms();
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        results[i] = dijkstra(graph, sources[i]);
+    }
+    double elapsed = now_ms() - start;
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        free_dijkstra_result(results[i]);
+    }
+    printf("dijkstra:                      %10.0f queries/s\n",
+           BENCH_QUERIES * 1000.0 / elapsed);
+
+    for (int w = 0; w < (int)(sizeof(widths) / sizeof(widths[0])); w++) {
+        start = now_ms();
+        dijkstra_interleaved(graph, sources, BENCH_QUERIES, widths[w], results);
+        elapsed = now_ms() - start;
+        for (int i = 0; i < BENCH_QUERIES; i++) {
+            free_dijkstra_result(results[i]);
+        }
+
+        printf("interleaved, width %-2d:        %10.0f queries/s\n",
+               widths[w], BENCH_QUERIES * 1000.0 / elapsed);
+    }
+
+    destroy_graph(graph);
+}
+
+/* The path export baseline in the style of print_path(): walk the parents
+ * of every vertex and format each hop with fprintf. */
+void export_paths_with_fprintf(FILE* stream, DijkstraResult result,
+                               int num_vertices, int source, int* path) {
+    for (int v = 0; v < num_vertices; v++) {
+        if (v == source) continue;
+
+        int length = 0;
+        for (int current = v; current != -1; current = result.parents[current]) {
+            path[length++] = current;
+        }
+
+        fprintf(stream, "Path from %d to %d (distance: %d): ",
+                source, v, result.distances[v]);
+        for (int i = length - 1; i >= 0; i--) {
+            fprintf(stream, "%d", path[i]);
+            if (i > 0) {
+                fprintf(stream, " -> ");
+            }
+        }
+        fprintf(stream, "\n");
+    }
+}
+
+void bench_result_export() {
+    int n = BENCH_EXPORT_VERTICES;
+    DijkstraResult result = {malloc(n * sizeof(int)), malloc(n * sizeof(int)), true};
+    int* path = malloc(n * sizeof(int));
+    FILE* sink = fopen("/dev/null", "w");
+
+    if (!result.distances || !result.parents || !path || !sink) {
+        printf("Skipping result export benchmark (setup failed)\n");
+        free(result.distances);
+        free(result.parents);
+        free(path);
+        if (sink) fclose(sink);
+        return;
+    }
+
+    /* Random recursive tree: a shallow shortest-path tree over 1M vertices. */
+    srand(7);
+    result.distances[0] = 0;
+    result.parents[0] = -1;
+    for (int v = 1; v < n; v++) {
+        result.parents[v] = rand() % v;
+        result.distances[v] = result.distances[result.parents[v]] + 1 + rand() % 100;
+    }
+
+    printf("\n=== Result export (%d-vertex shortest-path tree) ===\n", n);
+
+    double start = now_ms();
+    export_paths_with_fprintf(sink, result, n, 0, path);
+    printf("fprintf per hop, text paths:   %10.1f ms\n", now_ms() - start);
+
+    const char* names[] = {"text paths", "JSON lines", "binary"};
+    ResultFormat formats[] = {RESULT_TEXT, RESULT_JSON_LINES, RESULT_BINARY};
+
+    for (int f = 0; f < 3; f++) {
+        start = now_ms();
+        ResultWriter* writer = create_result_writer(sink, 0);
+        write_result_tree(writer, result, n, 0, formats[f]);
+        destroy_result_writer(writer);
+        printf("result writer, %-15s %10.1f ms\n", names[f], now_ms() - start);
+    }
+
+    fclose(sink);
+    free(path);
+    free(result.distances);
+    free(result.parents);
+}
+
+void bench_all_pairs() {
+    int degrees[] = {8, 64, 250};
+    const char* names[] = {"auto", "Floyd-Warshall", "Dijkstra"};
+
+    printf("\n=== All-pairs table (%d vertices, with predecessors) ===\n",
+           BENCH_VERTICES);
+
+    for (int d = 0; d < (int)(sizeof(degrees) / sizeof(degrees[0])); d++) {
+        Graph* graph = create_benchmark_graph(BENCH_VERTICES, degrees[d], 9);
+
+        double start = now_ms();
+        AllPairsTable* fw = build_all_pairs(graph, ALL_PAIRS_FLOYD_WARSHALL, true, 1);
+        double fw_time = now_ms() - start;
+
+        start = now_ms();
+        AllPairsTable* dj = build_all_pairs(graph, ALL_PAIRS_DIJKSTRA, true, 1);
+        double dj_time = now_ms() - start;
+
+        start = now_ms();
+        AllPairsTable* parallel = build_all_pairs(graph, ALL_PAIRS_DIJKSTRA, true,
+                                                  BENCH_THREADS);
+        double parallel_time = now_ms() - start;
+
+        printf("degree %-3d  Floyd-Warshall %8.1f ms, Dijkstra %8.1f ms, "
+               "%d threads %8.1f ms, auto: %s\n",
+               degrees[d], fw_time, dj_time, BENCH_THREADS, parallel_time,
+               names[choose_all_pairs_method(graph)]);
+
+        destroy_all_pairs(parallel);
+        destroy_all_pairs(dj);
+        destroy_all_pairs(fw);
+        destroy_graph(graph);
+    }
+}
+
+bool section_enabled(int argc, char** argv, const char* name) {
+    if (argc < 2) {
+        return true;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    printf("=== Dijkstra Performance Benchmarks ===\n");
+
+    if (section_enabled(argc, argv, "alloc")) {
+        bench_allocation_policies();
+    }
+    if (section_enabled(argc, argv, "snapshot")) {
+        bench_snapshot_updates();
+    }
+    if (section_enabled(argc, argv, "counters")) {
+        bench_hardware_counters();
+    }
+    if (section_enabled(argc, argv, "batch")) {
+        bench_batched_sources();
+    }
+    if (section_enabled(argc, argv, "reduce")) {
+        bench_graph_reduction();
+    }
+    if (section_enabled(argc, argv, "interleave")) {
+        bench_interleaved_queries();
+    }
+    if (section_enabled(argc, argv, "export")) {
+        bench_result_export();
+    }
+    if (section_enabled(argc, argv, "allpairs")) {
+        bench_all_pairs();
+    }
+
+    return 0;
+}